@@ -30,6 +30,7 @@
 #include <ql/pricingengines/swaption/g2swaptionengine.hpp>
 #include <ql/pricingengines/swaption/fdhullwhiteswaptionengine.hpp>
 #include <ql/pricingengines/swaption/fdg2swaptionengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/models/shortrate/onefactormodels/blackkarasinski.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
@@ -97,6 +98,55 @@ void calibrateModel(
     }
 }
 
+// Times repeated valuations of a Bermudan swaption on one Hull-White
+// tree, with and without the branching cache of the lattice
+void benchmarkRollback(const Swaption& swaption,
+                       const ext::shared_ptr<HullWhite>& model,
+                       const Handle<YieldTermStructure>& termStructure,
+                       Size timeSteps, Size repetitions) {
+
+    Swaption::arguments arguments;
+    swaption.setupArguments(&arguments);
+    Date referenceDate = termStructure->referenceDate();
+    DayCounter dayCounter = termStructure->dayCounter();
+
+    DiscretizedSwaption discretizedSwaption(arguments, referenceDate,
+                                            dayCounter);
+    std::vector<Time> times = discretizedSwaption.mandatoryTimes();
+    TimeGrid grid(times.begin(), times.end(), timeSteps);
+    ext::shared_ptr<Lattice> lattice = model->tree(grid);
+    ext::shared_ptr<OneFactorModel::ShortRateTree> tree =
+        ext::dynamic_pointer_cast<OneFactorModel::ShortRateTree>(lattice);
+
+    Time lastExercise =
+        dayCounter.yearFraction(referenceDate,
+                                arguments.exercise->lastDate());
+    Time firstExercise =
+        dayCounter.yearFraction(referenceDate,
+                                arguments.exercise->date(0));
+
+    std::cout << "Rollback on a " << timeSteps << "-step Hull-White tree, "
+              << repetitions << " valuations" << std::endl;
+    for (Size k=0; k<2; ++k) {
+        if (k == 0)
+            tree->disableBranchingCache();
+        else
+            tree->enableBranchingCache();
+
+        boost::timer timer;
+        Real npv = 0.0;
+        for (Size i=0; i<repetitions; ++i) {
+            discretizedSwaption.initialize(lattice, lastExercise);
+            discretizedSwaption.rollback(firstExercise);
+            npv = discretizedSwaption.presentValue();
+        }
+        std::cout << (k == 0 ? "without cache: " : "with cache:    ")
+                  << std::setprecision(6) << npv << " in "
+                  << std::setprecision(3) << timer.elapsed() << " s"
+                  << std::endl;
+    }
+}
+
 int main(int, char* []) {
 
     try {
@@ -389,7 +439,13 @@ int main(int, char* []) {
         itmBermudanSwaption.setPricingEngine(ext::shared_ptr<PricingEngine>(
             new TreeSwaptionEngine(modelBK, 50)));
         std::cout << "BK:              " << itmBermudanSwaption.NPV()
-                  << std::endl;
+                  << std::endl << std::endl;
+
+
+        // Tree rollback performance
+
+        benchmarkRollback(bermudanSwaption, modelHW, rhTermStructure,
+                          1000, 20);
 
         double seconds = timer.elapsed();
         Integer hours = int(seconds/3600);
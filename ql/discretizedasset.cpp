@@ -22,6 +22,20 @@
 
 namespace QuantLib {
 
+    void Lattice::rollback(
+                 const std::vector<ext::shared_ptr<DiscretizedAsset> >& assets,
+                 Time to) const {
+        for (Size i=0; i<assets.size(); ++i)
+            rollback(*assets[i], to);
+    }
+
+    void Lattice::partialRollback(
+                 const std::vector<ext::shared_ptr<DiscretizedAsset> >& assets,
+                 Time to) const {
+        for (Size i=0; i<assets.size(); ++i)
+            partialRollback(*assets[i], to);
+    }
+
     void DiscretizedOption::postAdjustValuesImpl() {
         /* In the real world, with time flowing forward, first
            any payment is settled and only after options can be
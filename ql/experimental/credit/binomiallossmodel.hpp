@@ -54,6 +54,10 @@ namespace QuantLib {
     parameter can then be dropped but the use of random recoveries should be
     added in some other way.
 
+    When the latent model integrates on a fixed set of nodes, the 
+    conditional distributions on the nodes are computed in parallel if 
+    OpenMP is enabled.
+
     \todo untested/wip for the random recovery models.
     \todo integrate with the previously computed probability inversions of
     the cumulative functions.
@@ -89,6 +93,22 @@ namespace QuantLib {
                 invProbs[iName] = 
                     copula_->inverseCumulativeY(invProbs[iName], iName);
 
+            if(copula_->hasFixedIntegrationNodes()) {
+                const std::vector<std::vector<Real> >& nodes = 
+                    copula_->integrationNodes();
+                std::vector<Real> weights = copula_->integrationWeights();
+                std::vector<std::vector<Real> > condProbs(nodes.size());
+                #pragma omp parallel for
+                for(long k=0; k<(long)nodes.size(); k++)
+                    condProbs[k] = 
+                        lossProbability(date, notionals, invProbs, nodes[k]);
+                std::vector<Real> result(condProbs[0].size(), 0.);
+                for(Size k=0; k<nodes.size(); k++)
+                    for(Size i=0; i<result.size(); i++)
+                        result[i] += weights[k] * condProbs[k][i];
+                return result;
+            }
+
             return copula_->integratedExpectedValue(
                 ext::function<Disposable<std::vector<Real> > (
                   const std::vector<Real>& v1)>(
@@ -340,6 +360,19 @@ namespace QuantLib {
         for(Size iName=0; iName<invProbs.size(); iName++)
             invProbs[iName] = 
                 copula_->inverseCumulativeY(invProbs[iName], iName);
+
+        if(copula_->hasFixedIntegrationNodes()) {
+            const std::vector<std::vector<Real> >& nodes = 
+                copula_->integrationNodes();
+            std::vector<Real> weights = copula_->integrationWeights();
+            std::vector<Real> condLosses(nodes.size());
+            #pragma omp parallel for
+            for(long k=0; k<(long)nodes.size(); k++)
+                condLosses[k] = condTrancheLoss(d, lossVals, notionals, 
+                    invProbs, nodes[k]);
+            return std::inner_product(weights.begin(), weights.end(), 
+                condLosses.begin(), 0.);
+        }
             
         return copula_->integratedExpectedValue(
             ext::function<Real (const std::vector<Real>& v1)>(
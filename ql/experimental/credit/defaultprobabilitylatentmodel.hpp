@@ -161,6 +161,29 @@ namespace QuantLib {
         
             return res;
         }
+        /*! Conditional default probabilities of all the names at once, for
+        loss models needing the whole pool at each integration point. The
+        arguments of the copula cumulative are computed first for all names
+        so that both loops run over contiguous data.
+        @param invCumYProbs Inverse cumulatives of the unconditional 
+          probabilities of default, as in the method above.
+        @param m Value of LM independent factors.
+        @param probs On return, the conditional probabilities of default.
+        */
+        void conditionalDefaultProbabilitiesInvP(
+            const std::vector<Real>& invCumYProbs,
+            const std::vector<Real>& m,
+            std::vector<Probability>& probs) const {
+            const Size n = invCumYProbs.size();
+            probs.resize(n);
+            for(Size iName=0; iName<n; iName++)
+                probs[iName] = (invCumYProbs[iName] -
+                    std::inner_product(factorWeights_[iName].begin(), 
+                        factorWeights_[iName].end(), m.begin(), 0.)) / 
+                    idiosyncFctrs_[iName];
+            for(Size iName=0; iName<n; iName++)
+                probs[iName] = cumulativeZ(probs[iName]);
+        }
     protected:
         /*! Returns the probability of default of a given name conditional on
         the realization of a given set of values of the model independent
@@ -37,6 +37,7 @@
 #include <ql/experimental/math/tcopulapolicy.hpp>
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <string>
 
 /* Intended to replace
     ql\experimental\credit\randomdefaultmodel.Xpp
@@ -75,10 +76,15 @@ namespace QuantLib {
     Generates the factors and variable samples and determines event threshold
     but it is not responsible for actual event specification; thats the derived
     classes responsibility according to what they model.
-    Derived classes need mainly to implement nextSample (Worker::nextSample in
-    the multithreaded version) to compute the simulation event generated, if
-    any, from the latent variables sample. They also have the accompanying
-    event trait to specify.
+    Derived classes need mainly to implement nextSample to compute the
+    simulation events generated, if any, from the latent variables sample.
+    They also have the accompanying event trait to specify.
+
+    The samples are drawn sequentially, so that results do not depend on the
+    number of threads, while the events they lead to (whose computation
+    involves solving for the default times) are computed in parallel when
+    OpenMP is enabled. nextSample must therefore be thread safe. The events
+    of all simulations are stored contiguously.
     */
     /* CRTP used for performance to avoid virtual table resolution in the Monte
     Carlo. Not only in sample generation but access; quite an amount of time can
@@ -102,7 +108,22 @@ namespace QuantLib {
         // random generation is performed in this class only.
         typedef typename LatentModel<copulaPolicy>::template FactorSampler<USNG>
             copulaRNG_type;
+        typedef simEvent<derivedRandomLM<copulaPolicy, USNG> > simEvent_type;
     protected:
+        //! Read-only access to the events of a simulation.
+        class SimEvents {
+          public:
+            SimEvents(const simEvent_type* begin, Size size)
+            : begin_(begin), size_(size) {}
+            Size size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+            const simEvent_type& operator[](Size i) const {
+                return begin_[i];
+            }
+          private:
+            const simEvent_type* begin_;
+            Size size_;
+        };
         RandomLM(Size numFactors,
             Size numLMVars,
             const copulaPolicy& copula,
@@ -112,7 +133,8 @@ namespace QuantLib {
           nSims_(nSims), copula_(copula) {}
 
         void update() {
-            simsBuffer_.clear();
+            simsEvents_.clear();
+            simsOffsets_.clear();
             // tell basket to notify instruments, etc, we are invalid
             if(!basket_.empty()) basket_->notifyObservers();
             LazyObject::update();
@@ -126,24 +148,56 @@ namespace QuantLib {
         }
 
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for(Size i=nSims_; i; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
-                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+            const derivedRandomLM<copulaPolicy, USNG>* model =
+                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(this);
+            simsEvents_.clear();
+            simsOffsets_.assign(1, 0);
+            simsOffsets_.reserve(nSims_+1);
+
+            // samples are processed in blocks to bound the memory used
+            const Size blockSize = std::min(nSims_, simsBlockSize_);
+            std::vector<std::vector<Real> > samples(blockSize);
+            std::vector<std::vector<simEvent_type> > events(blockSize);
+            std::vector<std::string> errors(blockSize);
+            for(Size first=0; first<nSims_; first+=blockSize) {
+                const Size n = std::min(blockSize, nSims_-first);
+                // the sequence generator is not thread safe
+                for(Size i=0; i<n; i++)
+                    samples[i] = copulasRng_->nextSequence().value;
+                // next sample should determine the events
+                #pragma omp parallel for
+                for(long i=0; i<(long)n; i++) {
+                    events[i].clear();
+                    try {
+                        model->nextSample(samples[i], events[i]);
+                    } catch (std::exception& e) {
+                        errors[i] = e.what();
+                    }
+                }
+                for(Size i=0; i<n; i++) {
+                    QL_REQUIRE(errors[i].empty(), "simulation " << first+i
+                               << " failed: " << errors[i]);
+                    simsEvents_.insert(simsEvents_.end(), events[i].begin(),
+                                       events[i].end());
+                    simsOffsets_.push_back(simsEvents_.size());
+                }
             }
         }
 
-        /* Method to access simulation results and avoiding a copy of
-        each thread results buffer. PerformCalculations should have been called.
-        Here in the monothread version this method is redundant/trivial but
-        serves to detach the statistics access to the way the simulations are
-        stored.
+        /* Method to access simulation results without copies.
+        PerformCalculations should have been called. It detaches the
+        statistics access from the way the simulations are stored.
+        */
+        SimEvents getSim(const Size iSim) const {
+            const Size first = simsOffsets_[iSim];
+            return SimEvents(simsEvents_.empty() ? 0 : &simsEvents_[first],
+                             simsOffsets_[iSim+1] - first);
+        }
+
+        /* Tranche losses of each simulation at the given date, in
+        simulation order. PerformCalculations should have been called.
         */
-        const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+        Disposable<std::vector<Real> > trancheLosses(const Date& d) const;
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
@@ -217,14 +271,17 @@ namespace QuantLib {
 
         const Size nSims_;
 
-        mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
-            USNG > > > > simsBuffer_;
+        // events of simulation i are in [simsOffsets_[i], simsOffsets_[i+1])
+        mutable std::vector<simEvent_type> simsEvents_;
+        mutable std::vector<Size> simsOffsets_;
 
         mutable copulaPolicy copula_;
         mutable ext::shared_ptr<copulaRNG_type> copulasRng_;
 
         // Maximum time inversion horizon
         static const Size maxHorizon_ = 4050; // over 11 years
+        // Number of samples held in memory during the simulation
+        static const Size simsBlockSize_ = 4096;
         // Inversion probability limits are computed by children in initdates()
     };
 
@@ -247,8 +304,7 @@ namespace QuantLib {
         Real counts = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
             Size simCount = 0;
-            const std::vector<simEvent<D<C, URNG> > >& events =
-                getSim(iSim);
+            const SimEvents events = getSim(iSim);
             for(Size iEvt=0; iEvt < events.size(); iEvt++)
                 // duck type on the members:
                 if(val > events[iEvt].dayFromRef) simCount++;
@@ -275,7 +331,7 @@ namespace QuantLib {
 
         std::vector<Probability> hitsByDate(basketSize, 0.);
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimEvents events = getSim(iSim);
             std::map<unsigned short, unsigned short> namesDefaulting;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 // if event is within time horizon...
@@ -320,7 +376,7 @@ namespace QuantLib {
         Real expectedDefi = 0.;
         Real expectedDefj = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimEvents events = getSim(iSim);
             Real imatch = 0., jmatch = 0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if((val > events[iEvt].dayFromRef) &&
@@ -344,15 +400,8 @@ namespace QuantLib {
 
 
     template<template <class, class> class D, class C, class URNG>
-    Real RandomLM<D, C, URNG>::expectedTrancheLoss(
-        const Date& d) const {
-            return expectedTrancheLossInterval(d, 0.95).first;
-    }
-
-
-    template<template <class, class> class D, class C, class URNG>
-    std::pair<Real, Real> RandomLM<D, C, URNG>::expectedTrancheLossInterval(
-        const Date& d, Probability confidencePerc) const
+    Disposable<std::vector<Real> > RandomLM<D, C, URNG>::trancheLosses(
+        const Date& d) const
     {
         calculate();
         Date today = Settings::instance().evaluationDate();
@@ -361,29 +410,55 @@ namespace QuantLib {
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
-        // Real trancheLoss= 0.;
-        GeneralStatistics lossStats;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+        std::vector<Real> losses(nSims_);
+        std::vector<std::string> errors(nSims_);
+        #pragma omp parallel for
+        for(long iSim=0; iSim < (long)nSims_; iSim++) {
+            const SimEvents events = getSim(iSim);
 
             Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                // if event is within time horizon...
-                if(val > static_cast<Date::serial_type>(
-					   events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
+            try {
+                for(Size iEvt=0; iEvt < events.size(); iEvt++) {
+                    // if event is within time horizon...
+                    if(val > static_cast<Date::serial_type>(
+                           events[iEvt].dayFromRef)) {
+                        Size iName = events[iEvt].nameIdx;
+          // test needed (here and the others) to reuse simulations:
+          //          if(basket_->pool()->has(copula_->pool()->names()[iName]))
                         portfSimLoss +=
                             basket_->exposure(basket_->names()[iName],
                                 Date(events[iEvt].dayFromRef +
                                     today.serialNumber())) *
                                         (1.-getEventRecovery(events[iEvt]));
-               }
+                    }
+                }
+            } catch (std::exception& e) {
+                errors[iSim] = e.what();
             }
-            lossStats.add(// d  ates? current losses? realized defaults, not yet
-                std::min(std::max(portfSimLoss - attachAmount, 0.),
-                    detachAmount - attachAmount) );
+            losses[iSim] = std::min(std::max(portfSimLoss - attachAmount, 0.),
+                detachAmount - attachAmount);
         }
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            QL_REQUIRE(errors[iSim].empty(), "simulation " << iSim
+                       << " failed: " << errors[iSim]);
+        return losses;
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    Real RandomLM<D, C, URNG>::expectedTrancheLoss(
+        const Date& d) const {
+            return expectedTrancheLossInterval(d, 0.95).first;
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    std::pair<Real, Real> RandomLM<D, C, URNG>::expectedTrancheLossInterval(
+        const Date& d, Probability confidencePerc) const
+    {
+        std::vector<Real> losses = trancheLosses(d);
+        GeneralStatistics lossStats;
+        lossStats.addSequence(losses.begin(), losses.end());
         return std::make_pair(lossStats.mean(), lossStats.errorEstimate() *
             InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc)));
     }
@@ -409,40 +484,11 @@ namespace QuantLib {
 
     template<template <class, class> class D, class C, class URNG>
     Histogram RandomLM<D, C, URNG>::computeHistogram(const Date& d) const {
-        std::vector<Real> data;
-        std::set<Real> keys;// attainable loss values
-        keys.insert(0.);
         Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
         // redundant test? should have been tested by the basket caller?
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
-        calculate();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-          // test needed (here and the others) to reuse simulations:
-          //          if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            data.push_back(std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount));
-            keys.insert(data.back());
-        }
+        std::vector<Real> data = trancheLosses(d);
         // avoid using as many points as in the simulation.
         Size nPts = std::min<Size>(data.size(), 150);// fix
         return Histogram(data.begin(), data.end(), nPts);
@@ -456,37 +502,10 @@ namespace QuantLib {
         const Date today = Settings::instance().evaluationDate();
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
-        calculate();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
         Date::serial_type val = d.serialNumber() - today.serialNumber();
         if(val <= 0) return 0.;// plus basket realized losses
 
-        //GenericRiskStatistics<GeneralStatistics> statsX;
-        std::vector<Real> losses;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					  events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                    //if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            losses.push_back(portfSimLoss);
-        }
-
+        std::vector<Real> losses = trancheLosses(d);
         std::sort(losses.begin(), losses.end());
         Real posit = std::ceil(percent * nSims_);
         posit = posit >= 0. ? posit : 0.;
@@ -551,35 +570,7 @@ namespace QuantLib {
 
         QL_REQUIRE(percentile >= 0. && percentile <= 1.,
             "Incorrect percentile");
-        calculate();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
-        std::vector<Real> rankLosses;
-        Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                 //   if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            // update dataset for rank stat:
-            rankLosses.push_back(portfSimLoss);
-        }
-
+        std::vector<Real> rankLosses = trancheLosses(d);
         std::sort(rankLosses.begin(), rankLosses.end());
         Size quantilePosition = static_cast<Size>(floor(nSims_*percentile));
         Real quantileValue = rankLosses[quantilePosition];
@@ -664,7 +655,7 @@ namespace QuantLib {
         Date::serial_type val = date.serialNumber() - today.serialNumber();
 
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimEvents events = getSim(iSim);
             Real portfSimLoss=0.;
             //std::vector<Real> splitBuffer(numLiveNames_, 0.);
             std::vector<simEvent<D<C, URNG> > > splitEventsBuffer;
@@ -877,7 +868,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+                        std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -887,6 +879,7 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const ext::shared_ptr<Pool>& pool = this->basket_->pool();
+            horizonDefaultPs_.clear();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
                     defaultProbability(this->basket_->defaultKeys()[iName])
@@ -936,11 +929,12 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
         const ext::shared_ptr<Pool>& pool = this->basket_->pool();
         // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
+        events.clear();
 
         for(Size iName=0; iName<model_->size(); iName++) {
             Real latentVarSample =
@@ -968,8 +962,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
-                    dateSTride));
+                events.push_back(defaultSimEvent(iName, dateSTride));
                //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster
@@ -37,6 +37,13 @@ namespace QuantLib {
         Notice that using copulas other than Gaussian it is only an
         approximation (see remark on p.68).
 
+        When the latent model integrates on a fixed set of nodes (e.g.
+        with a Gaussian quadrature) the conditional loss distributions on
+        the nodes are computed at once, in parallel if OpenMP is enabled,
+        and kept for each date. Since they do not depend on the tranche,
+        pricing several tranches on the same pool with the same model
+        instance reuses them.
+
         \todo Make the loss unit equal to some small fraction depending on the
         portfolio loss weights (notionals and recoveries). As it is now this
         is ok for pricing but not for risk metrics. See the discussion in O'Kane
@@ -107,10 +114,27 @@ namespace QuantLib {
     protected:
         const ext::shared_ptr<ConstantLossLatentmodel<copulaPolicy> > copula_;
     private:
+        /* Loss distributions, in loss units, conditional on the values of
+        the factors at the integration nodes. */
+        const std::vector<std::vector<Probability> >& 
+            conditionalDistributions(const Date& date) const;
+        void conditionalLossBuckets(const std::vector<Probability>& pDef,
+            std::vector<Probability>& distrib) const;
+        struct ConditionalDistributions {
+            std::vector<Real> invProbs;
+            std::vector<std::vector<Probability> > values;
+        };
         // loss model descriptor members
         const Size nBuckets_;
         mutable std::vector<Real> wk_;
         mutable Real lossUnit_;
+        // loss buckets attainable by the pool
+        mutable std::vector<bool> attainable_;
+        // cached conditional distributions; they are valid for the
+        //   evaluation date and factor weights they were computed with.
+        mutable std::map<Date, ConditionalDistributions> distributions_;
+        mutable Date distributionsDate_;
+        mutable std::vector<std::vector<Real> > distributionsFactors_;
         //! name to name factor. In the single factor copula:
         //    correl = beta * beta
         // When constructing through a single correlation number the factor is
@@ -171,6 +195,25 @@ namespace QuantLib {
 /**/
         using namespace ext::placeholders;
 
+        if(copula_->hasFixedIntegrationNodes()) {
+            const std::vector<std::vector<Probability> >& distribs = 
+                conditionalDistributions(date);
+            std::vector<Real> weights = copula_->integrationWeights();
+            Real expLoss = 0.;
+            for(Size k=0; k<distribs.size(); ++k) {
+                const std::vector<Probability>& distrib = distribs[k];
+                Real condLoss = 0.;
+                for(Size i=0; i<distrib.size(); ++i) {
+                    Real loss = i * lossUnit_;
+                    loss = std::min(std::max(loss - attachAmount_, 0.), 
+                        detachAmount_ - attachAmount_);
+                    condLoss += loss * distrib[i];
+                }
+                expLoss += weights[k] * condLoss;
+            }
+            return expLoss;
+        }
+
         std::vector<Probability> uncDefProb = 
             basket_->remainingProbabilities(date);
         std::vector<Real> invProb;
@@ -195,6 +238,21 @@ namespace QuantLib {
 
         using namespace ext::placeholders;
 
+        if(copula_->hasFixedIntegrationNodes()) {
+            const std::vector<std::vector<Probability> >& distribs = 
+                conditionalDistributions(date);
+            std::vector<Real> weights = copula_->integrationWeights();
+            std::vector<Real> results;
+            for(Size i=0; i<attainable_.size(); ++i) {
+                if(!attainable_[i]) continue;
+                Probability p = 0.;
+                for(Size k=0; k<distribs.size(); ++k)
+                    p += weights[k] * distribs[k][i];
+                results.push_back(p);
+            }
+            return results;
+        }
+
         std::vector<Probability> uncDefProb = 
             basket_->remainingProbabilities(date);
         return copula_->integratedExpectedValue(
@@ -230,8 +288,87 @@ namespace QuantLib {
         lgds.erase(std::remove(lgds.begin(), lgds.end(), 0.), lgds.end());
         lossUnit_ = *(std::min_element(lgds.begin(), lgds.end()))
             / nBuckets_;
+        std::vector<Real> wk;
         for(Size i=0; i<remainingBsktSize_; ++i)
-            wk_.push_back(std::floor(lgdsTmp[i]/lossUnit_ + .5));
+            wk.push_back(std::floor(lgdsTmp[i]/lossUnit_ + .5));
+        // the cached distributions are shared by baskets on the same pool
+        if(wk != wk_) {
+            wk_.swap(wk);
+            distributions_.clear();
+        }
+
+        Size maxLoss = 0;
+        for(Size i=0; i<remainingBsktSize_; ++i)
+            maxLoss += static_cast<Size>(wk_[i]);
+        attainable_ = std::vector<bool>(maxLoss+1, false);
+        attainable_[0] = true;
+        Size top = 0;
+        for(Size i=0; i<remainingBsktSize_; ++i) {
+            Size w = static_cast<Size>(wk_[i]);
+            for(Size j=top+1; j>0; --j)
+                if(attainable_[j-1]) attainable_[j-1+w] = true;
+            top += w;
+        }
+    }
+
+    template<class CP>
+    const std::vector<std::vector<Probability> >& 
+        RecursiveLossModel<CP>::conditionalDistributions(
+            const Date& date) const 
+    {
+        if(distributionsDate_ != Settings::instance().evaluationDate() ||
+            distributionsFactors_ != copula_->factorWeights()) {
+            distributions_.clear();
+            distributionsDate_ = Settings::instance().evaluationDate();
+            distributionsFactors_ = copula_->factorWeights();
+        }
+
+        std::vector<Probability> uncDefProb = 
+            basket_->remainingProbabilities(date);
+        std::vector<Real> invProb;
+        for(Size i=0; i<uncDefProb.size(); ++i)
+           invProb.push_back(copula_->inverseCumulativeY(uncDefProb[i], i));
+
+        ConditionalDistributions& cached = distributions_[date];
+        if(cached.invProbs == invProb && !cached.values.empty())
+            return cached.values;
+
+        const std::vector<std::vector<Real> >& nodes = 
+            copula_->integrationNodes();
+        std::vector<std::vector<Probability> > values(nodes.size());
+        #pragma omp parallel for
+        for(long k=0; k<(long)nodes.size(); ++k) {
+            std::vector<Probability> pDef;
+            copula_->conditionalDefaultProbabilitiesInvP(invProb, nodes[k], 
+                pDef);
+            conditionalLossBuckets(pDef, values[k]);
+        }
+        cached.invProbs.swap(invProb);
+        cached.values.swap(values);
+        return cached.values;
+    }
+
+    /* Same recursion as in conditionalLossDistrib, on a dense vector
+    indexed by the loss in loss units. Going through the losses downwards 
+    allows the update to be done in place. */
+    template<class CP>
+    void RecursiveLossModel<CP>::conditionalLossBuckets(
+        const std::vector<Probability>& pDef, 
+        std::vector<Probability>& distrib) const 
+    {
+        distrib = std::vector<Probability>(attainable_.size(), 0.);
+        distrib[0] = 1.;
+        Size top = 0;
+        for(Size iName=0; iName<remainingBsktSize_; ++iName) {
+            Size w = static_cast<Size>(wk_[iName]);
+            Probability p = pDef[iName];
+            for(Size j=top+1; j>0; --j) {
+                Probability x = distrib[j-1];
+                distrib[j-1] = x * (1.-p);
+                distrib[j-1+w] += x * p;
+            }
+            top += w;
+        }
     }
 
     // make it return a distribution object?
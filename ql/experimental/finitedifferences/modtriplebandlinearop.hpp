@@ -38,9 +38,19 @@ namespace QuantLib {
         explicit ModTripleBandLinearOp(const TripleBandLinearOp& m)
         : TripleBandLinearOp(m) { }
 
-        boost::shared_array<Real>& lower() { return lower_; }
-        boost::shared_array<Real>& diag()  { return diag_; }
-        boost::shared_array<Real>& upper() { return upper_; }
+        // the coefficients might be modified by the caller
+        boost::shared_array<Real>& lower() {
+            clearFactorization();
+            return lower_;
+        }
+        boost::shared_array<Real>& diag() {
+            clearFactorization();
+            return diag_;
+        }
+        boost::shared_array<Real>& upper() {
+            clearFactorization();
+            return upper_;
+        }
     };
 }
 
@@ -86,6 +86,18 @@ namespace QuantLib {
             const std::vector<Real>& arg)>& f) const {
             QL_FAIL("No vector integration provided");
         }
+        /* Integrators evaluating the integrand on a fixed set of nodes
+        can expose them; clients can then evaluate the integrand on all 
+        nodes at once and reuse the values across integrals.
+        */
+        virtual bool hasFixedNodes() const { return false; }
+        virtual const std::vector<std::vector<Real> >& nodes() const {
+            QL_FAIL("No fixed integration nodes provided");
+        }
+        // the integral of f is the sum of weights()[i] * f(nodes()[i])
+        virtual const std::vector<Real>& weights() const {
+            QL_FAIL("No fixed integration nodes provided");
+        }
         virtual ~LMIntegration() {}
     };
 
@@ -132,6 +144,16 @@ namespace QuantLib {
                 return GaussianQuadMultidimIntegrator::
                     integrate<Disposable<std::vector<Real> > >(f);
         }
+        // the grid is only stored when it has a reasonable size
+        bool hasFixedNodes() const {
+            return std::pow(Real(order()), Real(dimension())) <= 1.0e5;
+        }
+        const std::vector<std::vector<Real> >& nodes() const {
+            return GaussianQuadMultidimIntegrator::nodes();
+        }
+        const std::vector<Real>& weights() const {
+            return GaussianQuadMultidimIntegrator::weights();
+        }
         virtual ~IntegrationBase() {}
     };
 
@@ -615,6 +637,28 @@ namespace QuantLib {
                         ext::bind(&copulaPolicyImpl::density, copula_, _1),
                         ext::bind(ext::cref(f), _1)));
         }
+        /*! Whether the integration is performed on a fixed set of nodes
+            of the systemic factors. If so, integrationNodes() and
+            integrationWeights() allow to compute expected values as 
+            weighted sums of the integrand values on the nodes; models 
+            can then evaluate them in parallel and reuse them for 
+            several integrals.
+        */
+        bool hasFixedIntegrationNodes() const {
+            return integration()->hasFixedNodes();
+        }
+        const std::vector<std::vector<Real> >& integrationNodes() const {
+            return integration()->nodes();
+        }
+        //! Weights of the integration nodes times the factors density.
+        Disposable<std::vector<Real> > integrationWeights() const {
+            const std::vector<std::vector<Real> >& x = integration()->nodes();
+            const std::vector<Real>& w = integration()->weights();
+            std::vector<Real> weights(w.size());
+            for(Size i=0; i<w.size(); i++)
+                weights[i] = w[i] * copula_.density(x[i]);
+            return weights;
+        }
     protected:
         // Integrable models must provide their integrator.
         // Arguable, not having the integration in the LM class saves that 
@@ -35,6 +35,43 @@ namespace QuantLib {
         spawnFcts<maxDimensions_>();
     }
 
+    const std::vector<std::vector<Real> >&
+    GaussianQuadMultidimIntegrator::nodes() const {
+        if (nodes_.empty())
+            buildNodes();
+        return nodes_;
+    }
+
+    const std::vector<Real>& GaussianQuadMultidimIntegrator::weights() const {
+        if (weights_.empty())
+            buildNodes();
+        return weights_;
+    }
+
+    void GaussianQuadMultidimIntegrator::buildNodes() const {
+        const Array& x = integral_.x();
+        const Array& w = integral_.weights();
+        const Size n = x.size();
+        Size size = 1;
+        for (Size i=0; i<dimension_; ++i)
+            size *= n;
+
+        std::vector<std::vector<Real> > nodes(size,
+                                              std::vector<Real>(dimension_));
+        std::vector<Real> weights(size, 1.0);
+        // the first dimension runs fastest
+        for (Size k=0; k<size; ++k) {
+            Size index = k;
+            for (Size i=0; i<dimension_; ++i) {
+                nodes[k][i] = x[index % n];
+                weights[k] *= w[index % n];
+                index /= n;
+            }
+        }
+        nodes_.swap(nodes);
+        weights_.swap(weights);
+    }
+
 }
 
 #endif
@@ -92,6 +92,22 @@ namespace QuantLib {
             Real mu = 0.);
         //! Integration quadrature order.
         Size order() const {return integralV_.order();}
+        //! Number of dimensions of the integration domain.
+        Size dimension() const {return dimension_;}
+
+        //! \name Integration nodes
+        /*! The tensor product of the one-dimensional quadratures; the
+            integral of \f$ f \f$ is the sum over the nodes of
+            \f$ w_i f(x_i) \f$. They allow clients to evaluate the
+            integrand on all nodes at once, e.g. in parallel, and to
+            reuse its values for several integrals.
+            The nodes are built on the first call; there are
+            \f$ order^{dimension} \f$ of them.
+        */
+        //@{
+        const std::vector<std::vector<Real> >& nodes() const;
+        const std::vector<Real>& weights() const;
+        //@}
 
         //! Integrates function f over \f$ R^{dim} \f$
         /* This function is just syntax since the only thing it does is calling 
@@ -203,6 +219,10 @@ namespace QuantLib {
         Size dimension_;
         // integration veriable buffer
         mutable std::vector<Real> varBuffer_;
+        // tensor product nodes, built on demand
+        void buildNodes() const;
+        mutable std::vector<std::vector<Real> > nodes_;
+        mutable std::vector<Real> weights_;
     };
 
 
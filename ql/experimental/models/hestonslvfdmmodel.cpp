@@ -48,6 +48,7 @@
 #include <boost/assign/std/vector.hpp>
 
 #include <functional>
+#include <string>
 
 using namespace boost::assign;
 
@@ -481,31 +482,46 @@ namespace QuantLib {
                 const ext::shared_ptr<FdmScheme> fdmScheme(
                     fdmSchemeFactory(fdmSchemeDesc, hestonFwdOp));
 
-                for (Size j=0; j < x.size(); ++j) {
-                    Array pSlice(vGrid);
-                    for (Size k=0; k < vGrid; ++k)
-                        pSlice[k] = pn[j + k*xGrid];
-
-                    const Real pInt = (trafoType == FdmSquareRootFwdOp::Power)
-                       ? DiscreteSimpsonIntegral()(v, Pow(v, alpha-1)*pSlice)
-                       : DiscreteSimpsonIntegral()(v, pSlice);
-
-                    const Real vpInt = (trafoType == FdmSquareRootFwdOp::Log)
-                      ? DiscreteSimpsonIntegral()(v, Exp(v)*pSlice)
-                      : (trafoType == FdmSquareRootFwdOp::Power)
-                      ? DiscreteSimpsonIntegral()(v, Pow(v, alpha)*pSlice)
-                      : DiscreteSimpsonIntegral()(v, v*pSlice);
-
-                    const Real scale = pInt/vpInt;
-                    const Volatility localVol = localVol_->localVol(t, x[j]);
-
-                    const Real l = (scale >= 0.0)
-                      ? localVol*std::sqrt(scale) : 1.0;
-
-                    (*L)[j][i] = std::min(50.0, std::max(0.001, l));
-
-                    leverageFct->setInterpolation(Linear());
+                // the local volatility surface was already evaluated
+                // above, so that no lazy calculation is triggered
+                // by the concurrent calls below
+                std::vector<std::string> errors(x.size());
+                #pragma omp parallel for
+                for (long j=0; j < (long)x.size(); ++j) {
+                    try {
+                        Array pSlice(vGrid);
+                        for (Size k=0; k < vGrid; ++k)
+                            pSlice[k] = pn[j + k*xGrid];
+
+                        const Real pInt =
+                            (trafoType == FdmSquareRootFwdOp::Power)
+                          ? DiscreteSimpsonIntegral()(v, Pow(v, alpha-1)*pSlice)
+                          : DiscreteSimpsonIntegral()(v, pSlice);
+
+                        const Real vpInt =
+                            (trafoType == FdmSquareRootFwdOp::Log)
+                          ? DiscreteSimpsonIntegral()(v, Exp(v)*pSlice)
+                          : (trafoType == FdmSquareRootFwdOp::Power)
+                          ? DiscreteSimpsonIntegral()(v, Pow(v, alpha)*pSlice)
+                          : DiscreteSimpsonIntegral()(v, v*pSlice);
+
+                        const Real scale = pInt/vpInt;
+                        const Volatility localVol =
+                            localVol_->localVol(t, x[j]);
+
+                        const Real l = (scale >= 0.0)
+                          ? localVol*std::sqrt(scale) : 1.0;
+
+                        (*L)[j][i] = std::min(50.0, std::max(0.001, l));
+                    } catch (std::exception& e) {
+                        errors[j] = e.what();
+                    }
                 }
+                for (Size j=0; j < x.size(); ++j)
+                    QL_REQUIRE(errors[j].empty(),
+                               "leverage function calibration failed at "
+                               "strike " << x[j] << ": " << errors[j]);
+                leverageFct->setInterpolation(Linear());
 
                 const Real sLowerBound = std::max(x.front(),
                     std::exp(localVolRND.invcdf(
@@ -25,6 +25,7 @@
 #include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
 #include <ql/experimental/models/hestonslvmcmodel.hpp>
 #include <ql/experimental/processes/hestonslvprocess.hpp>
+#include <string>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -150,44 +151,66 @@ namespace QuantLib {
             }
         }
 
+        // The Brownian increments are drawn beforehand, so that the
+        // particles and the bins can be processed in parallel without
+        // changing the results. The term structures and the local
+        // volatility surface are evaluated first, so that no lazy
+        // calculation is triggered by the concurrent calls below.
+        rTS->discount(timeGrid_->back());
+        qTS->discount(timeGrid_->back());
+        std::vector<std::string> errors(std::max(calibrationPaths_, nBins_));
         for (Size n=1; n < timeGrid_->size(); ++n) {
             const Time t = timeGrid_->at(n-1);
             const Time dt = timeGrid_->dt(n-1);
 
-            Array x0(2), dw(2);
+            #pragma omp parallel for
+            for (long i=0; i < (long)calibrationPaths_; ++i) {
+                try {
+                    Array x0(2), dw(2);
+                    x0[0] = pairs[i].first;
+                    x0[1] = pairs[i].second;
 
-            for (Size i=0; i < calibrationPaths_; ++i) {
-                x0[0] = pairs[i].first;
-                x0[1] = pairs[i].second;
+                    dw[0] = paths[i][n-1][0];
+                    dw[1] = paths[i][n-1][1];
 
-                dw[0] = paths[i][n-1][0];
-                dw[1] = paths[i][n-1][1];
+                    x0 = slvProcess->evolve(t, x0, dt, dw);
 
-                x0 = slvProcess->evolve(t, x0, dt, dw);
-
-                pairs[i].first = x0[0];
-                pairs[i].second = x0[1];
+                    pairs[i].first = x0[0];
+                    pairs[i].second = x0[1];
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                }
             }
+            for (Size i=0; i < calibrationPaths_; ++i)
+                QL_REQUIRE(errors[i].empty(), "evolution of calibration "
+                           "path " << i << " failed: " << errors[i]);
 
             std::sort(pairs.begin(), pairs.end());
 
-            Size s = 0u, e = 0u;
-            for (Size i=0; i < nBins_; ++i) {
-                const Size inc = k + (i < m);
-                e = s + inc;
-
-                Real sum=0.0;
-                for (Size j=s; j < e; ++j) {
-                    sum+=pairs[j].second;
+            #pragma omp parallel for
+            for (long i=0; i < (long)nBins_; ++i) {
+                // bins hold k+1 paths first, then k paths
+                const Size s = i*k + std::min(Size(i), m);
+                const Size e = s + k + (Size(i) < m);
+                const Size inc = e - s;
+
+                try {
+                    Real sum=0.0;
+                    for (Size j=s; j < e; ++j) {
+                        sum+=pairs[j].second;
+                    }
+                    sum/=inc;
+
+                    vStrikes[n]->at(i) = 0.5*(pairs[e-1].first + pairs[s].first);
+                    (*L)[i][n] = std::sqrt(square<Real>()(
+                         localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
                 }
-                sum/=inc;
-
-                vStrikes[n]->at(i) = 0.5*(pairs[e-1].first + pairs[s].first);
-                (*L)[i][n] = std::sqrt(square<Real>()(
-                     localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
-
-                s = e;
             }
+            for (Size i=0; i < nBins_; ++i)
+                QL_REQUIRE(errors[i].empty(), "leverage function calibration "
+                           "failed at bin " << i << ": " << errors[i]);
 
             leverageFunction_->setInterpolation<Linear>();
         }
@@ -24,6 +24,38 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 namespace QuantLib {
 
+    namespace {
+
+        class VarianceGammaCharacteristicFunction {
+          public:
+            VarianceGammaCharacteristicFunction(Real sigma, Real nu,
+                                                Real theta, Time t)
+            : sigma_(sigma), nu_(nu), theta_(theta), t_(t),
+              omega_(std::log(1.0 - theta*nu - sigma*sigma*nu/2.0)/nu) {}
+
+            // characteristic function of ln(S_T/F_T)
+            std::complex<Real> operator()(const std::complex<Real>& u) const {
+                const std::complex<Real> i1(0, 1);
+                return std::exp(i1*u*omega_*t_)
+                    * std::pow(1.0 - i1*theta_*nu_*u
+                               + sigma_*sigma_*nu_*u*u/2.0, -t_/nu_);
+            }
+
+          private:
+            const Real sigma_, nu_, theta_;
+            const Time t_;
+            const Real omega_;
+        };
+    }
+
+    FFTSlicePricer::CharacteristicFunction
+    varianceGammaCharacteristicFunction(
+                      const ext::shared_ptr<VarianceGammaProcess>& process,
+                      Time t) {
+        return VarianceGammaCharacteristicFunction(
+            process->sigma(), process->nu(), process->theta(), t);
+    }
+
     FFTVarianceGammaEngine::FFTVarianceGammaEngine(
         const ext::shared_ptr<VarianceGammaProcess>& process, Real logStrikeSpacing)
         : FFTEngine(process, logStrikeSpacing)
@@ -26,6 +26,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #include <ql/experimental/variancegamma/fftengine.hpp>
 #include <ql/experimental/variancegamma/variancegammaprocess.hpp>
+#include <ql/pricingengines/vanilla/fftslicepricer.hpp>
 
 namespace QuantLib {
 
@@ -59,6 +60,15 @@ namespace QuantLib {
         Real theta_;
     };
 
+    //! characteristic function of the Variance Gamma model
+    /*! The returned function can be used with the FFTSlicePricer
+        to price all strikes of the expiry \f$ t \f$ at once.
+    */
+    FFTSlicePricer::CharacteristicFunction
+    varianceGammaCharacteristicFunction(
+                      const ext::shared_ptr<VarianceGammaProcess>& process,
+                      Time t);
+
 }
 
 
@@ -53,4 +53,16 @@ Real SviSmileSection::volatilityImpl(Rate strike) const {
     return std::sqrt(std::max(0.0, totalVariance / exerciseTime()));
 
 }
+
+void SviSmileSection::volatilitiesImpl(const std::vector<Rate> &strikes,
+                                       std::vector<Volatility> &vols) const {
+    const Real logForward = std::log(forward_);
+    const Time t = exerciseTime();
+    for (Size i = 0; i < strikes.size(); ++i) {
+        Real k = std::log(std::max(strikes[i], 1E-6)) - logForward;
+        Real totalVariance = detail::sviTotalVariance(
+            params_[0], params_[1], params_[2], params_[3], params_[4], k);
+        vols[i] = std::sqrt(std::max(0.0, totalVariance / t));
+    }
+}
 } // namespace QuantLib
@@ -44,6 +44,8 @@ class SviSmileSection : public SmileSection {
 
   protected:
     Volatility volatilityImpl(Rate strike) const;
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols) const;
 
   private:
     void init();
@@ -29,6 +29,7 @@
 #include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/experimental/volatility/zabr.hpp>
 #include <ql/termstructures/volatility/smilesectionutils.hpp>
+#include <algorithm>
 #include <vector>
 
 using std::exp;
@@ -68,6 +69,10 @@ template <typename Evaluation> class ZabrSmileSection : public SmileSection {
     Volatility volatilityImpl(Rate strike) const {
         return volatilityImpl(strike, Evaluation());
     }
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols) const {
+        volatilitiesImpl(strikes, vols, Evaluation());
+    }
 
   private:
     void init(const std::vector<Real> &moneyness) {
@@ -99,6 +104,15 @@ template <typename Evaluation> class ZabrSmileSection : public SmileSection {
     Volatility volatilityImpl(Rate strike, ZabrShortMaturityNormal) const;
     Volatility volatilityImpl(Rate strike, ZabrLocalVolatility) const;
     Volatility volatilityImpl(Rate strike, ZabrFullFd) const;
+    template <typename E>
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols, E) const {
+        for (Size i = 0; i < strikes.size(); ++i)
+            vols[i] = volatilityImpl(strikes[i], E());
+    }
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols,
+                          ZabrShortMaturityLognormal) const;
     ext::shared_ptr<ZabrModel> model_;
     Evaluation evaluation_;
     Rate forward_;
@@ -294,6 +308,25 @@ ZabrSmileSection<Evaluation>::volatilityImpl(Rate strike,
     return model_->lognormalVolatility(strike);
 }
 
+// the model integrates its ODE once along the sorted strikes
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::volatilitiesImpl(
+    const std::vector<Rate> &strikes, std::vector<Volatility> &vols,
+    ZabrShortMaturityLognormal) const {
+    if (strikes.empty())
+        return;
+    std::vector<Real> k(strikes.size());
+    for (Size i = 0; i < strikes.size(); ++i)
+        k[i] = std::max(1E-6, strikes[i]);
+    std::vector<Real> sorted(k);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    const std::vector<Real> v = model_->lognormalVolatility(sorted);
+    for (Size i = 0; i < k.size(); ++i)
+        vols[i] = v[std::lower_bound(sorted.begin(), sorted.end(), k[i]) -
+                    sorted.begin()];
+}
+
 template <typename Evaluation>
 Real
 ZabrSmileSection<Evaluation>::volatilityImpl(Rate strike,
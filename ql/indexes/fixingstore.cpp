@@ -0,0 +1,359 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/indexes/fixingstore.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#endif
+#include <boost/algorithm/string/case_conv.hpp>
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic pop
+#endif
+#include <fstream>
+
+using boost::algorithm::to_upper_copy;
+using std::string;
+
+namespace QuantLib {
+
+    namespace {
+
+        typedef Date::serial_type serial_type;
+
+        const char fileTag[] = "QLFIXINGS1";
+
+        // columns are stored densely if at least half of the days
+        // in their date range carry a fixing
+        const Size densityFactor = 2;
+
+        template <class T>
+        void write(std::ofstream& out, const T& x) {
+            out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+        }
+
+        template <class T>
+        void write(std::ofstream& out, const std::vector<T>& x) {
+            write(out, Size(x.size()));
+            if (!x.empty())
+                out.write(reinterpret_cast<const char*>(&x[0]),
+                          x.size()*sizeof(T));
+        }
+
+        template <class T>
+        void read(std::ifstream& in, T& x) {
+            in.read(reinterpret_cast<char*>(&x), sizeof(T));
+            QL_REQUIRE(in, "unexpected end of fixing file");
+        }
+
+        template <class T>
+        void read(std::ifstream& in, std::vector<T>& x) {
+            Size n;
+            read(in, n);
+            x.resize(n);
+            if (n > 0) {
+                in.read(reinterpret_cast<char*>(&x[0]), n*sizeof(T));
+                QL_REQUIRE(in, "unexpected end of fixing file");
+            }
+        }
+
+        class SerialLess {
+          public:
+            explicit SerialLess(const std::vector<serial_type>& s)
+            : s_(s) {}
+            bool operator()(Size i, Size j) const { return s_[i] < s_[j]; }
+          private:
+            const std::vector<serial_type>& s_;
+        };
+
+    }
+
+    FixingStore::Key FixingStore::key(const string& name) {
+        string n = to_upper_copy(name);
+        std::map<string, Key>::const_iterator i = keys_.find(n);
+        if (i != keys_.end())
+            return i->second;
+        Key k = names_.size();
+        keys_[n] = k;
+        names_.push_back(n);
+        columns_.push_back(ext::shared_ptr<const Column>());
+        return k;
+    }
+
+    bool FixingStore::hasKey(const string& name) const {
+        return keys_.find(to_upper_copy(name)) != keys_.end();
+    }
+
+    const string& FixingStore::name(Key key) const {
+        checkKey(key);
+        return names_[key];
+    }
+
+    void FixingStore::load(Key key,
+                           const std::vector<Date>& dates,
+                           const std::vector<Real>& values) {
+        QL_REQUIRE(dates.size() == values.size(),
+                   "number of dates (" << dates.size()
+                   << ") differs from number of values ("
+                   << values.size() << ")");
+        std::vector<serial_type> serials(dates.size());
+        for (Size i=0; i<dates.size(); ++i)
+            serials[i] = dates[i].serialNumber();
+        store(key, serials, values);
+    }
+
+    void FixingStore::load(Key key, const TimeSeries<Real>& fixings) {
+        std::vector<serial_type> serials;
+        std::vector<Real> values;
+        serials.reserve(fixings.size());
+        values.reserve(fixings.size());
+        for (TimeSeries<Real>::const_iterator i=fixings.begin();
+             i!=fixings.end(); ++i) {
+            serials.push_back(i->first.serialNumber());
+            values.push_back(i->second);
+        }
+        store(key, serials, values);
+    }
+
+    void FixingStore::loadDaily(Key key,
+                                const Date& firstDate,
+                                const std::vector<Real>& values) {
+        checkKey(key);
+        QL_REQUIRE(firstDate != Date(), "null first date given");
+        QL_REQUIRE(firstDate.serialNumber() + serial_type(values.size())
+                   <= Date::maxDate().serialNumber() + 1,
+                   "fixings beyond the maximum date given");
+
+        ext::shared_ptr<Column> c = ext::make_shared<Column>();
+        c->dense = true;
+        c->first = firstDate.serialNumber();
+        c->values = values;
+        for (Size i=0; i<values.size(); ++i)
+            if (values[i] != Null<Real>())
+                ++c->count;
+        if (c->count == 0)
+            c.reset();
+        columns_[key] = c;
+    }
+
+    void FixingStore::store(Key key,
+                            const std::vector<serial_type>& serials,
+                            const std::vector<Real>& values) {
+        checkKey(key);
+
+        // sort, unless the data are already in order as they
+        // usually are
+        std::vector<Size> order(serials.size());
+        for (Size i=0; i<order.size(); ++i)
+            order[i] = i;
+        bool sorted = true;
+        for (Size i=1; i<serials.size() && sorted; ++i)
+            sorted = serials[i-1] <= serials[i];
+        if (!sorted)
+            std::stable_sort(order.begin(), order.end(), SerialLess(serials));
+
+        std::vector<serial_type> s;
+        std::vector<Real> v;
+        s.reserve(serials.size());
+        v.reserve(serials.size());
+        for (Size i=0; i<order.size(); ++i) {
+            const Real x = values[order[i]];
+            if (x == Null<Real>())
+                continue;
+            const serial_type d = serials[order[i]];
+            if (!s.empty() && s.back() == d) {
+                QL_REQUIRE(v.back() == x,
+                           "different fixings given for " << Date(d)
+                           << ": " << v.back() << " and " << x);
+                continue;
+            }
+            s.push_back(d);
+            v.push_back(x);
+        }
+
+        if (s.empty()) {
+            columns_[key].reset();
+            return;
+        }
+
+        ext::shared_ptr<Column> c = ext::make_shared<Column>();
+        c->count = s.size();
+        c->first = s.front();
+        const Size span = Size(s.back() - s.front()) + 1;
+        if (span <= densityFactor*s.size()) {
+            c->dense = true;
+            c->values.resize(span, Null<Real>());
+            for (Size i=0; i<s.size(); ++i)
+                c->values[s[i]-c->first] = v[i];
+        } else {
+            c->dense = false;
+            c->dates.swap(s);
+            c->values.swap(v);
+        }
+        columns_[key] = c;
+    }
+
+    void FixingStore::clear(Key key) {
+        checkKey(key);
+        columns_[key].reset();
+    }
+
+    void FixingStore::clear() {
+        keys_.clear();
+        names_.clear();
+        columns_.clear();
+    }
+
+    Size FixingStore::fixings(Key key) const {
+        checkKey(key);
+        return columns_[key] ? columns_[key]->count : 0;
+    }
+
+    Date FixingStore::firstDate(Key key) const {
+        checkKey(key);
+        QL_REQUIRE(columns_[key], "no fixings stored for " << names_[key]);
+        const Column& c = *columns_[key];
+        if (c.dense) {
+            for (Size i=0; i<c.values.size(); ++i)
+                if (c.values[i] != Null<Real>())
+                    return Date(c.first + serial_type(i));
+        }
+        return Date(c.dates.front());
+    }
+
+    Date FixingStore::lastDate(Key key) const {
+        checkKey(key);
+        QL_REQUIRE(columns_[key], "no fixings stored for " << names_[key]);
+        const Column& c = *columns_[key];
+        if (c.dense) {
+            for (Size i=c.values.size(); i>0; --i)
+                if (c.values[i-1] != Null<Real>())
+                    return Date(c.first + serial_type(i-1));
+        }
+        return Date(c.dates.back());
+    }
+
+    bool FixingStore::isDense(Key key) const {
+        checkKey(key);
+        return columns_[key] && columns_[key]->dense;
+    }
+
+    TimeSeries<Real> FixingStore::timeSeries(Key key) const {
+        checkKey(key);
+        std::vector<Date> dates;
+        std::vector<Real> values;
+        if (columns_[key]) {
+            const Column& c = *columns_[key];
+            dates.reserve(c.count);
+            values.reserve(c.count);
+            for (Size i=0; i<c.values.size(); ++i) {
+                if (c.values[i] == Null<Real>())
+                    continue;
+                dates.push_back(Date(c.dense ? c.first + serial_type(i)
+                                             : c.dates[i]));
+                values.push_back(c.values[i]);
+            }
+        }
+        return TimeSeries<Real>(dates.begin(), dates.end(), values.begin());
+    }
+
+    FixingStore::Snapshot FixingStore::snapshot() const {
+        Snapshot s;
+        s.columns_ = columns_;
+        return s;
+    }
+
+    void FixingStore::restore(const Snapshot& snapshot) {
+        QL_REQUIRE(snapshot.columns_.size() <= columns_.size(),
+                   "snapshot taken from a different fixing store");
+        std::copy(snapshot.columns_.begin(), snapshot.columns_.end(),
+                  columns_.begin());
+        std::fill(columns_.begin() + snapshot.columns_.size(),
+                  columns_.end(), ext::shared_ptr<const Column>());
+    }
+
+    void FixingStore::save(const string& fileName) const {
+        std::ofstream out(fileName.c_str(), std::ios::binary);
+        QL_REQUIRE(out, "unable to open " << fileName << " for writing");
+        out.write(fileTag, sizeof(fileTag));
+
+        Size n = 0;
+        for (Size i=0; i<columns_.size(); ++i)
+            if (columns_[i])
+                ++n;
+        write(out, n);
+
+        for (Size i=0; i<columns_.size(); ++i) {
+            if (!columns_[i])
+                continue;
+            const Column& c = *columns_[i];
+            write(out, std::vector<char>(names_[i].begin(),
+                                         names_[i].end()));
+            write(out, c.dense);
+            write(out, c.first);
+            write(out, c.count);
+            write(out, c.dates);
+            write(out, c.values);
+        }
+        QL_REQUIRE(out, "error while writing " << fileName);
+    }
+
+    void FixingStore::loadFile(const string& fileName) {
+        std::ifstream in(fileName.c_str(), std::ios::binary);
+        QL_REQUIRE(in, "unable to open " << fileName);
+
+        char tag[sizeof(fileTag)];
+        in.read(tag, sizeof(tag));
+        QL_REQUIRE(in && std::equal(tag, tag + sizeof(tag), fileTag),
+                   fileName << " is not a fixing file");
+
+        Size n;
+        read(in, n);
+        // read everything before modifying the store, so that a
+        // corrupted file leaves it untouched
+        std::vector<string> names(n);
+        std::vector<ext::shared_ptr<const Column> > columns(n);
+        for (Size i=0; i<n; ++i) {
+            std::vector<char> name;
+            read(in, name);
+            names[i] = string(name.begin(), name.end());
+
+            ext::shared_ptr<Column> c = ext::make_shared<Column>();
+            read(in, c->dense);
+            read(in, c->first);
+            read(in, c->count);
+            read(in, c->dates);
+            read(in, c->values);
+            QL_REQUIRE(c->dense || c->dates.size() == c->values.size(),
+                       "inconsistent fixings for " << names[i]
+                       << " in " << fileName);
+            columns[i] = c;
+        }
+
+        for (Size i=0; i<n; ++i)
+            columns_[key(names[i])] = columns[i];
+    }
+
+    void FixingStore::publish() const {
+        for (Size i=0; i<columns_.size(); ++i)
+            // the history is set even if empty, so that the
+            // observers of the index are notified
+            IndexManager::instance().setHistory(names_[i], timeSeries(i));
+    }
+
+}
@@ -0,0 +1,200 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fixingstore.hpp
+    \brief columnar repository for large sets of index fixings
+*/
+
+#ifndef quantlib_fixing_store_hpp
+#define quantlib_fixing_store_hpp
+
+#include <ql/timeseries.hpp>
+#include <ql/shared_ptr.hpp>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! columnar repository for large sets of index fixings
+    /*! Fixings are stored per index in flat, sorted arrays instead
+        of one tree node per fixing.  Series whose fixings cover most
+        of their date range (such as daily fixings) are stored
+        densely, so that a fixing is found by its offset from the
+        first date; sparser series are stored as sorted date and
+        value arrays and searched by bisection.
+
+        Index names are interned: key() returns a handle that can be
+        used for repeated look-ups without any string comparison.
+        As for the IndexManager, names are case insensitive.
+
+        Columns are immutable once loaded and are shared between the
+        store and its snapshots; taking a snapshot therefore copies
+        no fixing data, which makes it cheap to save and restore the
+        state of the store in historical simulations.
+
+        The store is independent of the IndexManager; publish()
+        copies its contents into the latter so that they are seen by
+        Index::fixing().
+
+        \warning the binary files written by save() use the native
+                 byte order and are not meant to be exchanged between
+                 platforms.
+    */
+    class FixingStore {
+      public:
+        typedef Size Key;
+        class Snapshot;
+
+        //! \name Index names
+        //@{
+        //! returns the handle of the index, registering it if needed
+        Key key(const std::string& name);
+        //! returns whether the index was registered
+        bool hasKey(const std::string& name) const;
+        //! returns the (upper-case) name of the index
+        const std::string& name(Key key) const;
+        //! returns the number of registered indexes
+        Size size() const { return names_.size(); }
+        //@}
+
+        //! \name Loading fixings
+        /*! Each of the methods below replaces the fixings stored
+            for the given index.  Null values are not stored.
+        */
+        //@{
+        void load(Key key,
+                  const std::vector<Date>& dates,
+                  const std::vector<Real>& values);
+        template <class DateIterator, class ValueIterator>
+        void load(Key key, DateIterator dBegin, DateIterator dEnd,
+                  ValueIterator vBegin) {
+            std::vector<Date> dates(dBegin, dEnd);
+            std::vector<Real> values(dates.size());
+            for (Size i=0; i<dates.size(); ++i, ++vBegin)
+                values[i] = *vBegin;
+            load(key, dates, values);
+        }
+        void load(Key key, const TimeSeries<Real>& fixings);
+        //! loads one fixing per calendar day starting at firstDate
+        void loadDaily(Key key,
+                       const Date& firstDate,
+                       const std::vector<Real>& values);
+        //! clears the fixings of the index; its key stays valid
+        void clear(Key key);
+        //! clears all fixings and registered names
+        void clear();
+        //@}
+
+        //! \name Inspectors
+        //@{
+        //! returns Null<Real>() if no fixing was stored for the date
+        Real fixing(Key key, const Date& d) const;
+        bool hasFixing(Key key, const Date& d) const {
+            return fixing(key, d) != Null<Real>();
+        }
+        //! number of fixings stored for the index
+        Size fixings(Key key) const;
+        Date firstDate(Key key) const;
+        Date lastDate(Key key) const;
+        //! whether the fixings of the index are stored densely
+        bool isDense(Key key) const;
+        TimeSeries<Real> timeSeries(Key key) const;
+        //@}
+
+        //! \name Snapshots
+        //@{
+        Snapshot snapshot() const;
+        /*! Restores the fixings stored when the snapshot was taken.
+            Indexes registered afterwards keep their key but lose
+            their fixings.
+        */
+        void restore(const Snapshot& snapshot);
+        //@}
+
+        //! \name Persistence
+        //@{
+        //! writes all stored fixings to a binary file
+        void save(const std::string& fileName) const;
+        //! loads all fixings written to a binary file by save()
+        /*! The fixings in the file replace the ones stored for the
+            same indexes; other indexes are not modified.
+        */
+        void loadFile(const std::string& fileName);
+        //@}
+
+        //! copies the stored fixings into the IndexManager
+        void publish() const;
+
+      private:
+        struct Column {
+            Column() : first(0), dense(false), count(0) {}
+            Date::serial_type first;
+            bool dense;
+            Size count;
+            // serial numbers, for sparse columns only
+            std::vector<Date::serial_type> dates;
+            // for dense columns, values[i] is the fixing at first+i
+            std::vector<Real> values;
+        };
+        void checkKey(Key key) const;
+        void store(Key key,
+                   const std::vector<Date::serial_type>& dates,
+                   const std::vector<Real>& values);
+        std::map<std::string, Key> keys_;
+        std::vector<std::string> names_;
+        std::vector<ext::shared_ptr<const Column> > columns_;
+    };
+
+    //! saved state of a FixingStore
+    class FixingStore::Snapshot {
+        friend class FixingStore;
+      private:
+        std::vector<ext::shared_ptr<const Column> > columns_;
+    };
+
+
+    // inline definitions
+
+    inline void FixingStore::checkKey(Key key) const {
+        QL_REQUIRE(key < names_.size(), "invalid fixing-store key " << key);
+    }
+
+    inline Real FixingStore::fixing(Key key, const Date& d) const {
+        checkKey(key);
+        const Column* c = columns_[key].get();
+        if (!c)
+            return Null<Real>();
+        const Date::serial_type s = d.serialNumber();
+        if (c->dense) {
+            if (s < c->first
+                || s >= c->first + Date::serial_type(c->values.size()))
+                return Null<Real>();
+            return c->values[s - c->first];
+        } else {
+            std::vector<Date::serial_type>::const_iterator i =
+                std::lower_bound(c->dates.begin(), c->dates.end(), s);
+            if (i == c->dates.end() || *i != s)
+                return Null<Real>();
+            return c->values[i - c->dates.begin()];
+        }
+    }
+
+}
+
+#endif
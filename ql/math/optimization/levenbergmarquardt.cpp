@@ -28,9 +28,11 @@ namespace QuantLib {
     LevenbergMarquardt::LevenbergMarquardt(Real epsfcn,
                                            Real xtol,
                                            Real gtol,
-                                           bool useCostFunctionsJacobian)
+                                           bool useCostFunctionsJacobian,
+                                           bool parallelJacobian)
         : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
-          useCostFunctionsJacobian_(useCostFunctionsJacobian) {}
+          useCostFunctionsJacobian_(useCostFunctionsJacobian),
+          parallelJacobian_(parallelJacobian) {}
 
     Integer LevenbergMarquardt::getInfo() const {
         return info_;
@@ -100,7 +102,8 @@ namespace QuantLib {
                        ldfjac, ipvt.get(), qtf.get(),
                        wa1.get(), wa2.get(), wa3.get(), wa4.get(),
                        lmdifCostFunction,
-                       lmdifJacFunction);
+                       lmdifJacFunction,
+                       parallelJacobian_);
         info_ = info;
         // check requirements & endCriteria evaluation
         QL_REQUIRE(info != 0, "MINPACK: improper input parameters");
@@ -43,6 +43,12 @@ namespace QuantLib {
         (oder 2, but requiring more function
         evaluations) compared to the forward
         difference implemented here (order 1).
+        If parallelJacobian is true and the library
+        is compiled with OpenMP support, the columns
+        of the finite-difference jacobian are
+        computed concurrently; the cost function
+        must be safe to call from several threads
+        at once in that case.
 
         \ingroup optimizers
     */
@@ -51,7 +57,8 @@ namespace QuantLib {
         LevenbergMarquardt(Real epsfcn = 1.0e-8,
                            Real xtol = 1.0e-8,
                            Real gtol = 1.0e-8,
-                           bool useCostFunctionsJacobian = false);
+                           bool useCostFunctionsJacobian = false,
+                           bool parallelJacobian = false);
         virtual EndCriteria::Type minimize(Problem& P,
                                            const EndCriteria& endCriteria //= EndCriteria()
                                            );
@@ -75,6 +82,7 @@ namespace QuantLib {
         mutable Integer info_;
         const Real epsfcn_, xtol_, gtol_;
         bool useCostFunctionsJacobian_;
+        bool parallelJacobian_;
     };
 
 }
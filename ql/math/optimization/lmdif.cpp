@@ -62,8 +62,11 @@ or guarantee.
 */
 
 #include <ql/math/optimization/lmdif.hpp>
+#include <ql/errors.hpp>
 #include <cmath>
 #include <cstdio>
+#include <string>
+#include <vector>
 
 namespace QuantLib {
   namespace MINPACK {
@@ -256,7 +259,8 @@ return( k % m );
 void
 fdjac2(int m,int n,Real* x,Real* fvec,Real* fjac,int,
        int* iflag,Real epsfcn,Real* wa,
-       const QuantLib::MINPACK::LmdifCostFunction& fcn)
+       const QuantLib::MINPACK::LmdifCostFunction& fcn,
+       bool parallel = false)
 {
 /*
 *     **********
@@ -322,6 +326,11 @@ fdjac2(int m,int n,Real* x,Real* fvec,Real* fjac,int,
 *
 *   wa is a work array of length m.
 *
+*   parallel is an input variable. if true, the columns of the
+*     jacobian are computed concurrently (this requires OpenMP
+*     support and a reentrant fcn); each column then works on
+*     private copies of x and wa.
+*
 *     subprograms called
 *
 *   user-supplied ...... fcn
@@ -342,6 +351,39 @@ static double zero = 0.0;
 
 temp = dmax1(epsfcn,MACHEP);
 eps = std::sqrt(temp);
+if( parallel )
+    {
+    std::string error;
+    int flag = *iflag;
+    #pragma omp parallel for
+    for( long jj=0; jj<(long)n; jj++ )
+        {
+        int jc = (int)jj;
+        int iflagc = *iflag;
+        std::vector<Real> xc(x, x+n), wac(m);
+        Real tempc = xc[jc];
+        Real hc = eps * std::fabs(tempc);
+        if(hc == zero)
+            hc = eps;
+        xc[jc] = tempc + hc;
+        try {
+            fcn(m,n,&xc[0],&wac[0],&iflagc);
+        } catch (std::exception& e) {
+            #pragma omp critical(ql_fdjac2_error)
+            error = e.what();
+        }
+        if( iflagc < 0 )
+            {
+            #pragma omp critical(ql_fdjac2_error)
+            flag = iflagc;
+            }
+        for( int ic=0; ic<m; ic++ )
+            fjac[ic+m*jc] = (wac[ic] - fvec[ic])/hc;
+        }
+    QL_REQUIRE(error.empty(), error);
+    *iflag = flag;
+    return;
+    }
 ij = 0;
 for( j=0; j<n; j++ )
     {
@@ -1124,7 +1166,8 @@ void lmdif(int m,int n,Real* x,Real* fvec,Real ftol,
       int ldfjac,int* ipvt,Real* qtf,
       Real* wa1,Real* wa2,Real* wa3,Real* wa4,
       const QuantLib::MINPACK::LmdifCostFunction& fcn,
-      const QuantLib::MINPACK::LmdifCostFunction& jacFcn)
+      const QuantLib::MINPACK::LmdifCostFunction& jacFcn,
+      bool parallelJacobian)
 {
 /*
 *     **********
@@ -1367,7 +1410,8 @@ iflag = 2;
 if(jacFcn) // use user supplied jacobian calculation
     jacFcn(m,n,x,fjac,&iflag);
 else
-    fdjac2(m,n,x,fvec,fjac,ldfjac,&iflag,epsfcn,wa4, fcn);
+    fdjac2(m,n,x,fvec,fjac,ldfjac,&iflag,epsfcn,wa4, fcn,
+           parallelJacobian);
 *nfev += n;
 if(iflag < 0)
     goto L300;
@@ -44,7 +44,8 @@ namespace QuantLib {
                    int ldfjac,int* ipvt,Real* qtf,
                    Real* wa1,Real* wa2,Real* wa3,Real* wa4,
                    const LmdifCostFunction& fcn,
-                   const LmdifCostFunction& jacFcn);
+                   const LmdifCostFunction& jacFcn,
+                   bool parallelJacobian = false);
         
         void qrsolv(int n,Real* r,int ldr,int* ipvt,
                     Real* diag,Real* qtb, Real* x,
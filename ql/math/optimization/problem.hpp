@@ -120,6 +120,9 @@ namespace QuantLib {
     }
 
     inline Disposable<Array> Problem::values(const Array& x) {
+        // might be called concurrently by the parallel
+        // finite-difference jacobian of LevenbergMarquardt
+        #pragma omp atomic
         ++functionEvaluation_;
         return costFunction_.values(x);
     }
@@ -43,6 +43,13 @@ namespace QuantLib {
         requested to the 1-D underlying StatisticsType class, with the
         usual compile-time checks provided by the template approach.
 
+        Samples are buffered in blocks, so that the sum of their
+        outer products needed for the covariance is updated once per
+        block with a rank-k update instead of once per sample. The
+        update is performed in parallel when OpenMP is enabled.
+        Accumulators filled separately (e.g., by different threads)
+        can be merged if the underlying statistics class can.
+
         \test the correctness of the returned values is tested by
               checking them against numerical calculations.
     */
@@ -132,19 +139,38 @@ namespace QuantLib {
                        " required, " << std::distance(begin, end) <<
                        " provided");
 
-            quadraticSum_ += weight * outerProduct(begin, end,
-                                                   begin, end);
+            QL_REQUIRE(weight >= 0.0, "negative weight not allowed");
+
+            // square roots of the weights are buffered, so that the
+            // update of the quadratic sum is a plain rank-k update
+            const Real w = std::sqrt(weight);
+            Iterator it = begin;
+            for (Size i=0; i<dimension_; ++it, ++i)
+                buffer_[i][buffered_] = w * (*it);
+            if (++buffered_ == blockSize_)
+                flush();
 
             for (Size i=0; i<dimension_; ++begin, ++i)
                 stats_[i].add(*begin, weight);
 
         }
+        //! adds the samples collected by another accumulator
+        /*! \pre the underlying statistics class must provide a
+                 merge() method.
+        */
+        void merge(const GenericSequenceStatistics<StatisticsType>& other);
         //@}
       protected:
         Size dimension_;
         std::vector<statistics_type> stats_;
         mutable std::vector<Real> results_;
-        Matrix quadraticSum_;
+        // upper triangle only, up to the samples in the buffer
+        mutable Matrix quadraticSum_;
+      private:
+        void flush() const;
+        static const Size blockSize_ = 64;
+        mutable Matrix buffer_;
+        mutable Size buffered_;
     };
 
     //! default multi-dimensional statistics tool
@@ -158,7 +184,7 @@ namespace QuantLib {
 
     template <class Stat>
     inline GenericSequenceStatistics<Stat>::GenericSequenceStatistics(Size dimension)
-    : dimension_(0) {
+    : dimension_(0), buffered_(0) {
         reset(dimension);
     }
 
@@ -239,9 +265,48 @@ namespace QuantLib {
                 results_ = std::vector<Real>(dimension);
             }
             quadraticSum_ = Matrix(dimension_, dimension_, 0.0);
+            buffer_ = Matrix(dimension_, blockSize_);
         } else {
             dimension_ = dimension;
         }
+        buffered_ = 0;
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::flush() const {
+        const Size n = buffered_;
+        if (n == 0)
+            return;
+        #pragma omp parallel for schedule(dynamic) if(dimension_ > 32)
+        for (long i=0; i<(long)dimension_; ++i) {
+            Matrix::const_row_iterator xi = buffer_.row_begin(i);
+            for (Size j=i; j<dimension_; ++j) {
+                Matrix::const_row_iterator xj = buffer_.row_begin(j);
+                Real sum = 0.0;
+                for (Size k=0; k<n; ++k)
+                    sum += xi[k]*xj[k];
+                quadraticSum_[i][j] += sum;
+            }
+        }
+        buffered_ = 0;
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                        const GenericSequenceStatistics<Stat>& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+
+        flush();
+        other.flush();
+        quadraticSum_ += other.quadraticSum_;
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
     }
 
     template <class Stat>
@@ -257,9 +322,12 @@ namespace QuantLib {
         std::vector<Real> m = mean();
         Real inv = 1.0/sampleWeight;
 
-        Matrix result = inv*quadraticSum_;
-        result -= outerProduct(m.begin(), m.end(),
-                               m.begin(), m.end());
+        flush();
+        Matrix result(dimension_, dimension_);
+        for (Size i=0; i<dimension_; ++i)
+            for (Size j=i; j<dimension_; ++j)
+                result[i][j] = result[j][i] =
+                    inv*quadraticSum_[i][j] - m[i]*m[j];
 
         result *= (sampleNumber/(sampleNumber-1.0));
         return result;
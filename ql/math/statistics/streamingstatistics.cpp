@@ -0,0 +1,237 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        // scale function k_1 of Dunning and Ertl and its inverse
+        Real scale(Real q, Real compression) {
+            return compression/(2.0*M_PI)*std::asin(2.0*q-1.0);
+        }
+
+        Real inverseScale(Real k, Real compression) {
+            Real x = 2.0*M_PI*k/compression;
+            if (x >= M_PI_2)
+                return 1.0;
+            return 0.5*(std::sin(x)+1.0);
+        }
+
+    }
+
+    StreamingStatistics::StreamingStatistics(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression_ >= 10.0,
+                   "compression (" << compression_ << ") must be at least 10");
+        bufferSize_ = static_cast<Size>(5.0*compression_);
+        reset();
+    }
+
+    Real StreamingStatistics::mean() const {
+        QL_REQUIRE(samples() != 0, "empty sample set");
+        return mean_;
+    }
+
+    Real StreamingStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1,
+                   "sample number <=1, unsufficient");
+        return (m2_/weightSum_)*N/(N-1.0);
+    }
+
+    Real StreamingStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2,
+                   "sample number <=2, unsufficient");
+
+        Real x = m3_/weightSum_;
+        Real sigma = standardDeviation();
+
+        return (x/(sigma*sigma*sigma))*(N/(N-1.0))*(N/(N-2.0));
+    }
+
+    Real StreamingStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3,
+                   "sample number <=3, unsufficient");
+
+        Real x = m4_/weightSum_;
+        Real sigma2 = variance();
+
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+
+        return c1*(x/(sigma2*sigma2))-c2;
+    }
+
+    void StreamingStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight>=0.0, "negative weight not allowed");
+        min_ = samples_ == 0 ? value : std::min(min_, value);
+        max_ = samples_ == 0 ? value : std::max(max_, value);
+        ++samples_;
+        if (weight == 0.0)
+            return;
+        addMoments(weight, value, 0.0, 0.0, 0.0);
+        buffer_.push_back(Centroid(value, weight, 1));
+        if (buffer_.size() >= bufferSize_)
+            compress();
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        if (other.samples_ == 0)
+            return;
+        min_ = samples_ == 0 ? other.min_ : std::min(min_, other.min_);
+        max_ = samples_ == 0 ? other.max_ : std::max(max_, other.max_);
+        samples_ += other.samples_;
+        if (other.weightSum_ == 0.0)
+            return;
+        addMoments(other.weightSum_, other.mean_,
+                   other.m2_, other.m3_, other.m4_);
+        other.compress();
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        compress();
+    }
+
+    void StreamingStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = max_ = Null<Real>();
+        centroids_ = std::vector<Centroid>();
+        buffer_ = std::vector<Centroid>();
+        buffer_.reserve(bufferSize_);
+    }
+
+    /* Combines the central moments with those of another data set;
+       see P. Pebay, "Formulas for robust, one-pass parallel
+       computation of covariances and arbitrary-order statistical
+       moments", Sandia Report SAND2008-6212 (2008). */
+    void StreamingStatistics::addMoments(Real wb, Real meanb,
+                                         Real m2b, Real m3b, Real m4b) {
+        const Real wa = weightSum_, w = wa + wb;
+        const Real delta = meanb - mean_;
+        const Real d = delta/w, d2 = d*d;
+
+        m4_ += m4b + delta*d2*d*wa*wb*(wa*wa - wa*wb + wb*wb)
+            + 6.0*d2*(wa*wa*m2b + wb*wb*m2_) + 4.0*d*(wa*m3b - wb*m3_);
+        m3_ += m3b + delta*d2*wa*wb*(wa - wb) + 3.0*d*(wa*m2b - wb*m2_);
+        m2_ += m2b + delta*d*wa*wb;
+        mean_ += d*wb;
+        weightSum_ = w;
+    }
+
+    void StreamingStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end());
+
+        Real total = 0.0;
+        for (Size i=0; i<buffer_.size(); ++i)
+            total += buffer_[i].weight;
+
+        std::vector<Centroid> merged;
+        merged.reserve(centroids_.size() + 1);
+        Centroid current = buffer_.front();
+        // weight on the left of the current centroid
+        Real cumulated = 0.0;
+        Real limit = total*inverseScale(scale(0.0, compression_) + 1.0,
+                                        compression_);
+        for (Size i=1; i<buffer_.size(); ++i) {
+            const Centroid& next = buffer_[i];
+            if (cumulated + current.weight + next.weight <= limit) {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean)
+                    * next.weight/current.weight;
+                current.count += next.count;
+            } else {
+                cumulated += current.weight;
+                merged.push_back(current);
+                limit = total*inverseScale(
+                    scale(std::min(cumulated/total, 1.0), compression_) + 1.0,
+                    compression_);
+                current = next;
+            }
+        }
+        merged.push_back(current);
+
+        centroids_.swap(merged);
+        buffer_.clear();
+    }
+
+    Real StreamingStatistics::quantile(Real y, bool fromTop) const {
+        QL_REQUIRE(y > 0.0 && y <= 1.0,
+                   "percentile (" << y << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        compress();
+
+        /* The inverse cumulative distribution is interpolated
+           linearly between the centres of the centroids, the
+           minimum and the maximum.  Single samples are not
+           spread; as in GeneralStatistics, they are returned for
+           the whole range of weight they carry. */
+        std::vector<std::pair<Real,Real> > knots;
+        knots.reserve(2*centroids_.size() + 2);
+        knots.push_back(std::make_pair(0.0, min_));
+        Real cumulated = 0.0;
+        for (Size i=0; i<centroids_.size(); ++i) {
+            const Centroid& c = centroids_[i];
+            if (c.count == 1) {
+                knots.push_back(std::make_pair(cumulated, c.mean));
+                knots.push_back(std::make_pair(cumulated+c.weight, c.mean));
+            } else {
+                knots.push_back(std::make_pair(cumulated+0.5*c.weight,
+                                               c.mean));
+            }
+            cumulated += c.weight;
+        }
+        knots.push_back(std::make_pair(cumulated, max_));
+
+        const Real target = y*cumulated;
+        if (!fromTop) {
+            for (Size i=1; i<knots.size(); ++i) {
+                if (knots[i].first >= target) {
+                    const Real x0 = knots[i-1].first, x1 = knots[i].first;
+                    if (close(x0, x1))
+                        return knots[i].second;
+                    return knots[i-1].second + (target - x0)/(x1 - x0)
+                        * (knots[i].second - knots[i-1].second);
+                }
+            }
+        } else {
+            for (Size i=knots.size()-1; i>0; --i) {
+                const Real x0 = cumulated - knots[i].first,
+                           x1 = cumulated - knots[i-1].first;
+                if (x1 >= target) {
+                    if (close(x0, x1))
+                        return knots[i-1].second;
+                    return knots[i].second + (target - x0)/(x1 - x0)
+                        * (knots[i-1].second - knots[i].second);
+                }
+            }
+        }
+        return fromTop ? knots.front().second : knots.back().second;
+    }
+
+}
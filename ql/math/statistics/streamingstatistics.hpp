@@ -0,0 +1,266 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief statistics tool with bounded memory and approximate quantiles
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory
+    /*! This class can be used in place of GeneralStatistics when
+        the number of samples is too large for all of them to be
+        stored, e.g., as the statistics policy of a Monte Carlo
+        engine simulating millions of paths.
+
+        Mean, variance, skewness and kurtosis are accumulated
+        exactly with numerically stable updates of the central
+        moments.  Percentiles are estimated from a merging t-digest,
+        i.e., a sorted set of weighted centroids whose size is
+        bounded by the compression parameter \f$ \delta \f$ and
+        which is denser in the tails of the distribution; see
+
+        T. Dunning and O. Ertl, "Computing extremely accurate
+        quantiles using t-digests", arXiv:1902.04023 (2019).
+
+        The memory used is \f$ O(\delta) \f$ regardless of the
+        number of samples.  Centroids are merged as long as they
+        cover no more than a fraction
+        \f[ \Delta q \le \frac{2\pi}{\delta} \sqrt{q(1-q)} \f]
+        of the total weight, \f$ q \f$ being their cumulated weight
+        fraction; this is the bound on the error on the probability
+        level \f$ q \f$ of the returned percentiles.  With the
+        default \f$ \delta = 200 \f$, it amounts to 1.6% at the
+        median, 0.3% at the 1% percentile and 0.1% at the 0.1%
+        percentile; errors are usually much smaller in practice.
+        Samples are kept as they are as long as their number is
+        below about \f$ \delta/2 \f$, in which case the results of
+        percentile() and topPercentile() coincide with those of
+        GeneralStatistics.
+
+        Two accumulators can be merged, which allows each thread
+        of a parallel simulation to collect its own samples.
+
+        \warning expectationValue() treats each centroid as a
+                 single sample and is therefore an approximation.
+                 Since centroids are small in the tails, this
+                 approximation is usually good for tail measures
+                 such as the expected shortfall.
+    */
+    class StreamingStatistics {
+      public:
+        typedef Real value_type;
+        explicit StreamingStatistics(Real compression = 200.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const { return samples_; }
+
+        //! sum of data weights
+        Real weightSum() const { return weightSum_; }
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! Approximate expectation value of a function \f$ f \f$ on
+            a given range \f$ \mathcal{R} \f$, evaluated on the
+            centroids of the digest.  The range is passed as a
+            boolean function returning <tt>true</tt> if the argument
+            belongs to the range or <tt>false</tt> otherwise.
+
+            The function returns a pair made of the result and
+            the number of observations in the given range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            std::vector<Centroid>::const_iterator i;
+            for (i=centroids_.begin(); i!=centroids_.end(); ++i) {
+                Real x = i->mean, w = i->weight;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += i->count;
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! estimate of the \f$ y \f$-th percentile, defined as the
+            value \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! estimate of the \f$ y \f$-th top percentile, defined as
+            the value \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+
+        //! compression parameter of the digest
+        Real compression() const { return compression_; }
+        //! current number of centroids of the digest
+        Size centroids() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another accumulator
+        void merge(const StreamingStatistics& other);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Centroid(Real mean, Real weight, Size count)
+            : mean(mean), weight(weight), count(count) {}
+            Real mean, weight;
+            Size count;
+            bool operator<(const Centroid& c) const { return mean < c.mean; }
+        };
+        void addMoments(Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        void compress() const;
+        Real quantile(Real y, bool fromTop) const;
+
+        Real compression_;
+        Size bufferSize_;
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_;
+        Real min_, max_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+    };
+
+    //! risk measures based on streaming statistics
+    typedef GenericRiskStatistics<GenericGaussianStatistics<
+                                           StreamingStatistics> >
+                                                    StreamingRiskStatistics;
+
+
+    // inline definitions
+
+    inline Real StreamingStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real StreamingStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+    inline Real StreamingStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    inline Real StreamingStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+    inline Real StreamingStatistics::percentile(Real y) const {
+        return quantile(y, false);
+    }
+
+    inline Real StreamingStatistics::topPercentile(Real y) const {
+        return quantile(y, true);
+    }
+
+    inline Size StreamingStatistics::centroids() const {
+        compress();
+        return centroids_.size();
+    }
+
+}
+
+
+#endif
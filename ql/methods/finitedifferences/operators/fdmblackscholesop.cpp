@@ -47,13 +47,17 @@ namespace QuantLib {
       mapT_  (direction, mesher),
       strike_(strike),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
-      direction_(direction) {
+      direction_(direction),
+      r_(Null<Real>()), q_(Null<Real>()), v_(Null<Real>()),
+      mapUnchanged_(false) {
     }
 
     void FdmBlackScholesOp::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
+        mapUnchanged_ = false;
+
         if (localVol_) {
             const ext::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
             const FdmLinearOpIterator endIter = layout->end();
@@ -83,6 +87,15 @@ namespace QuantLib {
         else {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
+
+            // over intervals with constant coefficients the operator,
+            // and its factorisation, are kept as they are
+            if (r == r_ && q == q_ && v == v_) {
+                mapUnchanged_ = true;
+                return;
+            }
+            r_ = r; q_ = q; v_ = v;
+
             mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_,
                         dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
                         Array(1, -r));
@@ -114,8 +127,11 @@ namespace QuantLib {
 
     Disposable<Array> FdmBlackScholesOp::solve_splitting(Size direction,
                                                 const Array& r, Real dt) const {
-        if (direction == direction_)
+        if (direction == direction_) {
+            if (mapUnchanged_)
+                mapT_.factorize(dt, 1.0);
             return mapT_.solve_splitting(r, dt, 1.0);
+        }
         else {
             Array retVal(r);
             return retVal;
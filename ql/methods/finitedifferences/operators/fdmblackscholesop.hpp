@@ -70,6 +70,10 @@ namespace QuantLib {
         const Real strike_;
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
+        // coefficients of mapT_ and whether the last call to
+        // setTime() left them unchanged
+        Real r_, q_, v_;
+        bool mapUnchanged_;
     };
 }
 
@@ -42,7 +42,9 @@ namespace QuantLib {
       rTS_(rTS),
       qTS_(qTS),
       quantoHelper_(quantoHelper),
-      leverageFct_(leverageFct) {
+      leverageFct_(leverageFct),
+      r_(Null<Rate>()), q_(Null<Rate>()),
+      mapUnchanged_(false) {
 
         // on the boundary s_min and s_max the second derivative
         // d^2V/dS^2 is zero and due to Ito's Lemma the variance term
@@ -63,6 +65,13 @@ namespace QuantLib {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
+        // without quanto adjustment and leverage function, the map
+        // (and its factorisation) only changes together with r and q
+        mapUnchanged_ = !quantoHelper_ && !leverageFct_ && r == r_ && q == q_;
+        if (mapUnchanged_)
+            return;
+        r_ = r; q_ = q;
+
         if (quantoHelper_) {
             mapT_.axpyb(r - q - varianceValues_
                 - quantoHelper_->quantoAdjustment(
@@ -121,11 +130,19 @@ namespace QuantLib {
              .add(FirstDerivativeOp(1, mesher)
                   .mult(kappa*(theta - mesher->locations(1))))),
       mapT_(1, mesher),
-      rTS_(rTS) {
+      rTS_(rTS),
+      r_(Null<Rate>()),
+      mapUnchanged_(false) {
     }
 
     void FdmHestonVariancePart::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
+
+        mapUnchanged_ = (r == r_);
+        if (mapUnchanged_)
+            return;
+        r_ = r;
+
         mapT_.axpyb(Array(), dyMap_, dyMap_, Array(1,-0.5*r));
     }
 
@@ -185,9 +202,13 @@ namespace QuantLib {
                                      const Array& r, Real a) const {
 
         if (direction == 0) {
+            if (dxMap_.isMapUnchanged())
+                dxMap_.getMap().factorize(a, 1.0);
             return dxMap_.getMap().solve_splitting(r, a, 1.0);
         }
         else if (direction == 1) {
+            if (dyMap_.isMapUnchanged())
+                dyMap_.getMap().factorize(a, 1.0);
             return dyMap_.getMap().solve_splitting(r, a, 1.0);
         }
         else
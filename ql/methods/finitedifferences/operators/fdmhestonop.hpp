@@ -50,6 +50,8 @@ namespace QuantLib {
         void setTime(Time t1, Time t2);
         const TripleBandLinearOp& getMap() const;
         const Array& getL() const { return L_; }
+        //! whether the last call to setTime() left the map unchanged
+        bool isMapUnchanged() const { return mapUnchanged_; }
 
       protected:
         Disposable<Array> getLeverageFctSlice(Time t1, Time t2) const;
@@ -63,6 +65,9 @@ namespace QuantLib {
         const ext::shared_ptr<YieldTermStructure> rTS_, qTS_;
         const ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
         const ext::shared_ptr<LocalVolTermStructure> leverageFct_;
+
+        Rate r_, q_;
+        bool mapUnchanged_;
     };
 
     class FdmHestonVariancePart {
@@ -74,12 +79,17 @@ namespace QuantLib {
 
         void setTime(Time t1, Time t2);
         const TripleBandLinearOp& getMap() const;
+        //! whether the last call to setTime() left the map unchanged
+        bool isMapUnchanged() const { return mapUnchanged_; }
 
       protected:
         const TripleBandLinearOp dyMap_;
         TripleBandLinearOp mapT_;
 
         const ext::shared_ptr<YieldTermStructure> rTS_;
+
+        Rate r_;
+        bool mapUnchanged_;
     };
 
 
@@ -20,6 +20,7 @@
 */
 
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/errors.hpp>
 
 namespace QuantLib {
 
@@ -85,4 +86,47 @@ namespace QuantLib {
 
         return retVal;
     }
+
+    boost::shared_array<Size> FdmLinearOpLayout::neighbours(
+                                      Size direction, Integer offset) const {
+        QL_REQUIRE(direction < dim_.size(),
+                   "direction (" << direction << ") out of range");
+        QL_REQUIRE(offset == -1 || offset == 1,
+                   "offset (" << offset << ") must be either -1 or 1");
+        calculateTables(direction);
+        return (offset == -1) ? lowerNeighbours_[direction]
+                              : upperNeighbours_[direction];
+    }
+
+    boost::shared_array<Size> FdmLinearOpLayout::lines(
+                                                   Size direction) const {
+        QL_REQUIRE(direction < dim_.size(),
+                   "direction (" << direction << ") out of range");
+        calculateTables(direction);
+        return lines_[direction];
+    }
+
+    void FdmLinearOpLayout::calculateTables(Size direction) const {
+        // operators might be built concurrently on the same layout
+        #pragma omp critical(fdmlinearoplayout_tables)
+        if (!lines_[direction]) {
+            const Size n = dim_[direction], s = spacing_[direction];
+            boost::shared_array<Size> lower(new Size[size_]),
+                                      upper(new Size[size_]),
+                                      lines(new Size[size_]);
+            for (Size i=0; i < size_; ++i) {
+                const Size c = (i/s)%n;
+                lower[i] = (c == 0)   ? i+s : i-s;
+                upper[i] = (c == n-1) ? i-s : i+s;
+
+                // lines are ordered as the remaining coordinates,
+                // nodes within a line by their coordinate
+                const Size line = i%s + (i/(s*n))*s;
+                lines[line*n + c] = i;
+            }
+            lowerNeighbours_[direction] = lower;
+            upperNeighbours_[direction] = upper;
+            lines_[direction] = lines;
+        }
+    }
 }
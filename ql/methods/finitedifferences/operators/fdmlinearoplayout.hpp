@@ -27,6 +27,7 @@
 #define quantlib_linear_op_layout_hpp
 
 #include <ql/methods/finitedifferences/operators/fdmlinearopiterator.hpp>
+#include <boost/shared_array.hpp>
 #include <functional>
 
 namespace QuantLib {
@@ -34,7 +35,9 @@ namespace QuantLib {
     class FdmLinearOpLayout {
       public:
         explicit FdmLinearOpLayout(const std::vector<Size>& dim)
-        : dim_(dim), spacing_(dim.size()) {
+        : dim_(dim), spacing_(dim.size()),
+          lowerNeighbours_(dim.size()), upperNeighbours_(dim.size()),
+          lines_(dim.size()) {
             spacing_[0] = 1;
             std::partial_sum(dim.begin(), dim.end()-1,
                 spacing_.begin()+1, std::multiplies<Size>());
@@ -79,9 +82,31 @@ namespace QuantLib {
         Disposable<FdmLinearOpIterator> iter_neighbourhood(
             const FdmLinearOpIterator& iterator, Size i, Integer offset) const;
 
+        /*! returns a table whose i-th element is the index of the
+            neighbour of the i-th node at the given offset (either -1
+            or 1) along the given direction, reflected at the
+            boundaries as in neighbourhood().  Tables are calculated once and shared by
+            all operators defined on the layout; they must not be
+            modified.
+        */
+        boost::shared_array<Size> neighbours(Size direction,
+                                             Integer offset) const;
+
+        /*! returns a permutation of the node indices in which the
+            nodes on each line along the given direction are
+            contiguous and in increasing order.  The table is shared
+            as above.
+        */
+        boost::shared_array<Size> lines(Size direction) const;
+
       private:
+        void calculateTables(Size direction) const;
+
         Size size_;
         std::vector<Size> dim_, spacing_;
+        mutable std::vector<boost::shared_array<Size> > lowerNeighbours_,
+                                                         upperNeighbours_,
+                                                         lines_;
     };
 }
 
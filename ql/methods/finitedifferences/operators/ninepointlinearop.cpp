@@ -30,12 +30,8 @@ namespace QuantLib {
         const ext::shared_ptr<FdmMesher>& mesher)
     : d0_(d0), d1_(d1),
       i00_(new Size[mesher->layout()->size()]),
-      i10_(new Size[mesher->layout()->size()]),
       i20_(new Size[mesher->layout()->size()]),
-      i01_(new Size[mesher->layout()->size()]),
-      i21_(new Size[mesher->layout()->size()]),
       i02_(new Size[mesher->layout()->size()]),
-      i12_(new Size[mesher->layout()->size()]),
       i22_(new Size[mesher->layout()->size()]),
       a00_(new Real[mesher->layout()->size()]),
       a10_(new Real[mesher->layout()->size()]),
@@ -54,31 +50,29 @@ namespace QuantLib {
             "inconsistent derivative directions");
 
         const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
-
-            i10_[i] = layout->neighbourhood(iter, d1_, -1);
-            i01_[i] = layout->neighbourhood(iter, d0_, -1);
-            i21_[i] = layout->neighbourhood(iter, d0_,  1);
-            i12_[i] = layout->neighbourhood(iter, d1_,  1);
-            i00_[i] = layout->neighbourhood(iter, d0_, -1, d1_, -1);
-            i20_[i] = layout->neighbourhood(iter, d0_,  1, d1_, -1);
-            i02_[i] = layout->neighbourhood(iter, d0_, -1, d1_,  1);
-            i22_[i] = layout->neighbourhood(iter, d0_,  1, d1_,  1);
+
+        i10_ = layout->neighbours(d1_, -1);
+        i01_ = layout->neighbours(d0_, -1);
+        i21_ = layout->neighbours(d0_,  1);
+        i12_ = layout->neighbours(d1_,  1);
+
+        // reflecting along d0 doesn't change the coordinate along d1,
+        // hence the diagonal neighbours can be found in two moves
+        const Size size = layout->size();
+        for (Size i=0; i < size; ++i) {
+            i00_[i] = i10_[i01_[i]];
+            i20_[i] = i10_[i21_[i]];
+            i02_[i] = i12_[i01_[i]];
+            i22_[i] = i12_[i21_[i]];
         }
     }
 
     NinePointLinearOp::NinePointLinearOp(const NinePointLinearOp& m)
-    : i00_(new Size[m.mesher_->layout()->size()]),
-      i10_(new Size[m.mesher_->layout()->size()]),
-      i20_(new Size[m.mesher_->layout()->size()]),
-      i01_(new Size[m.mesher_->layout()->size()]),
-      i21_(new Size[m.mesher_->layout()->size()]),
-      i02_(new Size[m.mesher_->layout()->size()]),
-      i12_(new Size[m.mesher_->layout()->size()]),
-      i22_(new Size[m.mesher_->layout()->size()]),
+    : d0_(m.d0_), d1_(m.d1_),
+      // index tables are never modified and can be shared
+      i00_(m.i00_), i10_(m.i10_), i20_(m.i20_),
+      i01_(m.i01_), i21_(m.i21_),
+      i02_(m.i02_), i12_(m.i12_), i22_(m.i22_),
       a00_(new Real[m.mesher_->layout()->size()]),
       a10_(new Real[m.mesher_->layout()->size()]),
       a20_(new Real[m.mesher_->layout()->size()]),
@@ -91,14 +85,6 @@ namespace QuantLib {
       mesher_(m.mesher_) {
 
         const Size size = mesher_->layout()->size();
-        std::copy(m.i00_.get(), m.i00_.get()+size, i00_.get());
-        std::copy(m.i10_.get(), m.i10_.get()+size, i10_.get());
-        std::copy(m.i20_.get(), m.i20_.get()+size, i20_.get());
-        std::copy(m.i01_.get(), m.i01_.get()+size, i01_.get());
-        std::copy(m.i21_.get(), m.i21_.get()+size, i21_.get());
-        std::copy(m.i02_.get(), m.i02_.get()+size, i02_.get());
-        std::copy(m.i12_.get(), m.i12_.get()+size, i12_.get());
-        std::copy(m.i22_.get(), m.i22_.get()+size, i22_.get());
         std::copy(m.a00_.get(), m.a00_.get()+size, a00_.get());
         std::copy(m.a10_.get(), m.a10_.get()+size, a10_.get());
         std::copy(m.a20_.get(), m.a20_.get()+size, a20_.get());
@@ -144,8 +130,8 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
+        #pragma omp parallel for
+        for (long i=0; i < (long)retVal.size(); ++i) {
             retVal[i] =   a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
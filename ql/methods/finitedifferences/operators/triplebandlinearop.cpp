@@ -31,50 +31,25 @@ namespace QuantLib {
         Size direction,
         const ext::shared_ptr<FdmMesher>& mesher)
     : direction_(direction),
-      i0_       (new Size[mesher->layout()->size()]),
-      i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
+      i0_       (mesher->layout()->neighbours(direction, -1)),
+      i2_       (mesher->layout()->neighbours(direction,  1)),
+      reverseIndex_ (mesher->layout()->lines(direction)),
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
-      mesher_(mesher) {
-
-        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        std::vector<Size> newDim(layout->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
-
-            i0_[i] = layout->neighbourhood(iter, direction, -1);
-            i2_[i] = layout->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
-        }
-    }
+      mesher_(mesher) {}
 
     TripleBandLinearOp::TripleBandLinearOp(const TripleBandLinearOp& m)
     : direction_(m.direction_),
-      i0_   (new Size[m.mesher_->layout()->size()]),
-      i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
+      // index tables are never modified and can be shared
+      i0_   (m.i0_),
+      i2_   (m.i2_),
+      reverseIndex_(m.reverseIndex_),
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
       mesher_(m.mesher_) {
         const Size len = m.mesher_->layout()->size();
-        std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
-        std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
-        std::copy(m.reverseIndex_.get(), m.reverseIndex_.get()+len,
-                  reverseIndex_.get());
         std::copy(m.lower_.get(), m.lower_.get() + len, lower_.get());
         std::copy(m.diag_.get(),  m.diag_.get() + len,  diag_.get());
         std::copy(m.upper_.get(), m.upper_.get() + len, upper_.get());
@@ -106,12 +81,19 @@ namespace QuantLib {
         i0_.swap(m.i0_); i2_.swap(m.i2_);
         reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
+
+        std::swap(factorA_, m.factorA_); std::swap(factorB_, m.factorB_);
+        pivots_.swap(m.pivots_);
+        lowerFactors_.swap(m.lowerFactors_);
+        upperFactors_.swap(m.upperFactors_);
     }
 
     void TripleBandLinearOp::axpyb(const Array& a,
                                    const TripleBandLinearOp& x,
                                    const TripleBandLinearOp& y,
                                    const Array& b) {
+        clearFactorization();
+
         const Size size = mesher_->layout()->size();
 
         Real *diag(diag_.get());
@@ -257,8 +239,8 @@ namespace QuantLib {
         const Size* i2ptr = i2_.get();
 
         array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
+        #pragma omp parallel for
+        for (long i=0; i < (long)index->size(); ++i) {
             retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
 
@@ -300,34 +282,139 @@ namespace QuantLib {
 
         Array retVal(r.size()), tmp(r.size());
 
+        if (isFactorized(a, b)) {
+            const Size* rptr = reverseIndex_.get();
+            const Real* pptr = pivots_.get();
+            const Real* lfptr = lowerFactors_.get();
+            const Real* ufptr = upperFactors_.get();
+
+            const Size n = layout->dim()[direction_];
+            const Size nLines = layout->size()/n;
+
+            #pragma omp parallel for
+            for (long l=0; l < (long)nLines; ++l) {
+                const Size first = l*n, last = first + n;
+
+                Size rim1 = rptr[first];
+                retVal[rim1] = r[rim1]*pptr[first];
+                for (Size j=first+1; j < last; j++) {
+                    const Size ri = rptr[j];
+                    retVal[ri] = r[ri]*pptr[j] - lfptr[j]*retVal[rim1];
+                    rim1 = ri;
+                }
+                for (Size j=last-1; j > first; --j)
+                    retVal[rptr[j-1]] -= ufptr[j]*retVal[rptr[j]];
+            }
+            return retVal;
+        }
+
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
+        const Size* rptr = reverseIndex_.get();
+
+        // The system decouples into one tridiagonal system for each
+        // line along the direction; in the reverse index these lines
+        // are contiguous and can be solved independently.
+        const Size n = layout->dim()[direction_];
+        const Size nLines = layout->size()/n;
+        std::vector<char> singular(nLines, false);
 
         // Thomson algorithm to solve a tridiagonal system.
         // Example code taken from Tridiagonalopertor and
         // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        #pragma omp parallel for
+        for (long l=0; l < (long)nLines; ++l) {
+            const Size first = l*n, last = first + n;
+
+            Size rim1 = rptr[first];
+            Real bet=1.0/(a*dptr[rim1]+b);
+            if (bet == 0.0) {
+                singular[l] = true;
+                continue;
+            }
+            retVal[rim1] = r[rim1]*bet;
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+            for (Size j=first+1; j < last; j++){
+                const Size ri = rptr[j];
+                tmp[j] = a*uptr[rim1]*bet;
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
+                if (bet == 0.0) {
+                    singular[l] = true;
+                    break;
+                }
+                bet=1.0/bet;
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
+                rim1 = ri;
+            }
+            // cannot be j>=first with Size j
+            for (Size j=last-1; j > first; --j)
+                retVal[rptr[j-1]] -= tmp[j]*retVal[rptr[j]];
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        QL_ENSURE(std::find(singular.begin(), singular.end(), true)
+                  == singular.end(), "division by zero");
 
         return retVal;
     }
+
+    void TripleBandLinearOp::factorize(Real a, Real b) const {
+        if (isFactorized(a, b))
+            return;
+        clearFactorization();
+
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size size = layout->size();
+        const Size n = layout->dim()[direction_];
+
+        const Real* lptr = lower_.get();
+        const Real* dptr = diag_.get();
+        const Real* uptr = upper_.get();
+        const Size* rptr = reverseIndex_.get();
+
+        boost::shared_array<Real> pivots(new Real[size]);
+        boost::shared_array<Real> lowerFactors(new Real[size]);
+        boost::shared_array<Real> upperFactors(new Real[size]);
+
+        for (Size first=0; first < size; first+=n) {
+            Size rim1 = rptr[first];
+            Real bet = 1.0/(a*dptr[rim1]+b);
+            // singular systems are left to solve_splitting to report
+            if (bet == 0.0)
+                return;
+            pivots[first] = bet;
+            lowerFactors[first] = upperFactors[first] = 0.0;
+
+            for (Size j=first+1; j < first+n; ++j) {
+                const Size ri = rptr[j];
+                upperFactors[j] = a*uptr[rim1]*bet;
+
+                bet = b + a*(dptr[ri] - upperFactors[j]*lptr[ri]);
+                if (bet == 0.0)
+                    return;
+                bet = 1.0/bet;
+
+                pivots[j] = bet;
+                lowerFactors[j] = a*lptr[ri]*bet;
+                rim1 = ri;
+            }
+        }
+
+        factorA_ = a;
+        factorB_ = b;
+        pivots_ = pivots;
+        lowerFactors_ = lowerFactors;
+        upperFactors_ = upperFactors;
+    }
+
+    void TripleBandLinearOp::clearFactorization() const {
+        pivots_.reset();
+        lowerFactors_.reset();
+        upperFactors_.reset();
+    }
+
+    bool TripleBandLinearOp::isFactorized(Real a, Real b) const {
+        return pivots_ && factorA_ == a && factorB_ == b;
+    }
 }
@@ -48,6 +48,19 @@ namespace QuantLib {
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
 
+        /*! Precomputes the pivots of the Thomas algorithm for the
+            systems \f$ (a\,L + b)\,x = r \f$, so that subsequent
+            calls to solve_splitting() with the same \f$ a \f$ and
+            \f$ b \f$ only perform the substitutions.  This pays off
+            when the operator is left unchanged over several time
+            steps.  The factorisation is dropped by axpyb() and is not
+            copied; it must be dropped with clearFactorization() if
+            the coefficients are modified otherwise.
+        */
+        void factorize(Real a, Real b = 1.0) const;
+        void clearFactorization() const;
+        bool isFactorized(Real a, Real b = 1.0) const;
+
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
         Disposable<TripleBandLinearOp> multR(const Array& u) const;
@@ -74,6 +87,11 @@ namespace QuantLib {
         boost::shared_array<Real> lower_, diag_, upper_;
 
         ext::shared_ptr<FdmMesher> mesher_;
+
+      private:
+        // factorisation of a*L+b, stored in the order of reverseIndex_
+        mutable Real factorA_, factorB_;
+        mutable boost::shared_array<Real> pivots_, lowerFactors_, upperFactors_;
     };
 }
 
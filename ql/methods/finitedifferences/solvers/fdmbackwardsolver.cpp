@@ -81,6 +81,16 @@ namespace QuantLib {
         return FdmSchemeDesc(FdmSchemeDesc::TrBDF2Type, 2 - M_SQRT2, 1e-8);
     }
 
+    FdmSchemeDesc FdmSchemeDesc::Adaptive(Real tolerance,
+                                          Real relInitStepSize) {
+        return FdmSchemeDesc(
+            FdmSchemeDesc::AdaptiveType, tolerance, relInitStepSize);
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::Richardson() {
+        return FdmSchemeDesc(FdmSchemeDesc::RichardsonType, 0.5, 0.0);
+    }
+
     FdmBackwardSolver::FdmBackwardSolver(
         const ext::shared_ptr<FdmLinearOpComposite>& map,
         const FdmBoundaryConditionSet& bcSet,
@@ -103,7 +113,8 @@ namespace QuantLib {
         const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
                     
         if (   dampingSteps 
-            && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
+            && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType
+            && schemeDesc_.type != FdmSchemeDesc::RichardsonType) {
             ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
             FiniteDifferenceModel<ImplicitEulerScheme> 
                     dampingModel(implicitEvolver, condition_->stoppingTimes());
@@ -190,8 +201,100 @@ namespace QuantLib {
                 trBDF2Model.rollback(rhs, dampingTo, to, steps, *condition_);
             }
             break;
+          case FdmSchemeDesc::AdaptiveType:
+            {
+                rollbackAdaptive(rhs, dampingTo, to);
+            }
+            break;
+          case FdmSchemeDesc::RichardsonType:
+            {
+                // the damping steps are part of both rollbacks, so
+                // that their error is extrapolated as well
+                FdmBackwardSolver douglasSolver(
+                    map_, bcSet_, condition_,
+                    FdmSchemeDesc(FdmSchemeDesc::DouglasType,
+                                  schemeDesc_.theta, 0.0));
+
+                array_type coarse(rhs);
+                douglasSolver.rollback(coarse, from, to,
+                                       steps, dampingSteps);
+                douglasSolver.rollback(rhs, from, to,
+                                       2*steps, 2*dampingSteps);
+
+                for (Size i=0; i < rhs.size(); ++i)
+                    rhs[i] += (rhs[i] - coarse[i])/3.0;
+            }
+            break;
           default:
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    void FdmBackwardSolver::rollbackAdaptive(
+        FdmBackwardSolver::array_type& rhs, Time from, Time to) {
+
+        const Real tolerance = schemeDesc_.theta;
+        QL_REQUIRE(tolerance > 0.0,
+                   "positive tolerance required, " << tolerance << " given");
+
+        // Crank-Nicolson (Douglas with theta=1/2) and TR-BDF2 are both
+        // of second order; their difference estimates the local error.
+        DouglasScheme cnEvolver(0.5, map_, bcSet_);
+        const FdmSchemeDesc trDesc = FdmSchemeDesc::CraigSneyd();
+        const ext::shared_ptr<CraigSneydScheme> csEvolver(
+            ext::make_shared<CraigSneydScheme>(
+                trDesc.theta, trDesc.mu, map_, bcSet_));
+        const FdmSchemeDesc trBDF2Desc = FdmSchemeDesc::TrBDF2();
+        TrBDF2Scheme<CraigSneydScheme> trBDF2(
+            trBDF2Desc.theta, map_, csEvolver, bcSet_, trBDF2Desc.mu);
+
+        const std::vector<Time>& stoppingTimes = condition_->stoppingTimes();
+        if (!stoppingTimes.empty() && stoppingTimes.back() == from)
+            condition_->applyTo(rhs, from);
+
+        const Time minStep = 1e-6*(from - to);
+        const Time eps = std::sqrt(QL_EPSILON)*std::max(from - to, 1.0);
+
+        Time t = from;
+        Time dt = std::max(schemeDesc_.mu*(from - to), minStep);
+        while (t - to > eps) {
+            // the step must not jump over the next stopping time
+            Time next = to;
+            for (Size j=0; j < stoppingTimes.size(); ++j)
+                if (stoppingTimes[j] > next && stoppingTimes[j] < t - eps)
+                    next = stoppingTimes[j];
+            const bool lastStep = (t - next <= dt);
+            const Time h = lastStep ? t - next : dt;
+
+            array_type cn(rhs), tr(rhs);
+            cnEvolver.setStep(h);
+            cnEvolver.step(cn, t);
+            trBDF2.setStep(h);
+            trBDF2.step(tr, t);
+
+            Real diff = 0.0, scale = QL_EPSILON;
+            for (Size i=0; i < tr.size(); ++i) {
+                diff = std::max(diff, std::fabs(cn[i] - tr[i]));
+                scale = std::max(scale, std::fabs(tr[i]));
+            }
+            const Real error = diff/scale;
+
+            // the local error of both schemes is O(h^3)
+            const Real factor = (error > 0.0)
+                ? std::min(4.0, std::max(0.2,
+                                  0.9*std::pow(tolerance/error, 1.0/3.0)))
+                : 4.0;
+
+            if (error <= tolerance || h <= minStep) {
+                rhs.swap(tr);
+                t = lastStep ? next : t - h;
+                condition_->applyTo(rhs, t);
+                // a step shortened to hit a stopping time does not
+                // limit the following ones
+                dt = std::max(h*factor, lastStep ? dt : 0.0);
+            } else {
+                dt = std::max(h*factor, minStep);
+            }
+        }
+    }
 }
@@ -36,7 +36,8 @@ namespace QuantLib {
         enum FdmSchemeType { HundsdorferType, DouglasType, 
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType,
-                             MethodOfLinesType, TrBDF2Type };
+                             MethodOfLinesType, TrBDF2Type,
+                             AdaptiveType, RichardsonType };
 
         FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
 
@@ -54,6 +55,20 @@ namespace QuantLib {
         static FdmSchemeDesc MethodOfLines(
             Real eps=0.001, Real relInitStepSize=0.01);
         static FdmSchemeDesc TrBDF2();
+        /*! TR-BDF2 steps whose sizes are chosen so that the
+            difference to a Crank-Nicolson step from the same values,
+            relative to the largest value, stays below the given
+            tolerance; the number of time steps passed to the solver
+            is not used.
+        */
+        static FdmSchemeDesc Adaptive(
+            Real tolerance=1e-5, Real relInitStepSize=0.01);
+        /*! Douglas scheme on the given time grid and on one with
+            twice the number of time and damping steps; the results
+            are combined by Richardson extrapolation assuming
+            second-order convergence.
+        */
+        static FdmSchemeDesc Richardson();
     };
         
     class FdmBackwardSolver {
@@ -71,6 +86,8 @@ namespace QuantLib {
                       Size steps, Size dampingSteps);
 
       protected:
+        void rollbackAdaptive(array_type& a, Time from, Time to);
+
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const ext::shared_ptr<FdmStepConditionComposite> condition_;
@@ -47,6 +47,7 @@ namespace QuantLib {
                                 Size) const { return discount_; }
 
         void stepback(Size i, const Array& values, Array& newValues) const;
+        void stepback(Size i, const Matrix& values, Matrix& newValues) const;
 
         Real underlying(Size i, Size index) const {
             return tree_->underlying(i, index);
@@ -88,6 +89,15 @@ namespace QuantLib {
             newValues[j] = (pd_*values[j] + pu_*values[j+1])*discount_;
     }
 
+    template <class T>
+    void BlackScholesLattice<T>::stepback(Size i, const Matrix& values,
+                                          Matrix& newValues) const {
+        for (Size j=0; j<size(i); j++)
+            for (Size k=0; k<values.columns(); k++)
+                newValues[j][k] =
+                    (pd_*values[j][k] + pu_*values[j+1][k])*discount_;
+    }
+
 }
 
 
@@ -27,6 +27,7 @@
 
 #include <ql/numericalmethod.hpp>
 #include <ql/discretizedasset.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
 
 namespace QuantLib {
@@ -49,7 +50,28 @@ namespace QuantLib {
           void stepback(Size i,
                         const Array& values,
                         Array& newValues) const;
+          void stepback(Size i,
+                        const Matrix& values,
+                        Matrix& newValues) const;
         \endcode
+        (derived classes redefining one of the stepback() overloads
+        must redefine the other one, too.)
+
+        A set of assets initialized at the same time on the lattice
+        can be rolled back together.  Their values are then stored as
+        the columns of a matrix whose rows are the lattice nodes, so
+        that each step is a single dense kernel in which the branching
+        of each node is read once for all assets.
+
+        Unless disabled, the default stepback() implementation
+        stores the descendants, probabilities and discount factors of
+        each time step in flat arrays the first time the step is
+        rolled back; later rollbacks over the same step, e.g., of the
+        underlying of an option or of other assets priced on the same
+        lattice, then run over contiguous memory without calling back
+        into the derived class.  Derived classes whose discount
+        factors or probabilities can change after construction must
+        call resetBranchingCache() when that happens.
 
         \ingroup lattices
     */
@@ -63,6 +85,7 @@ namespace QuantLib {
             QL_REQUIRE(n>0, "there is no zeronomial lattice!");
             statePrices_ = std::vector<Array>(1, Array(1, 1.0));
             statePricesLimit_ = 0;
+            cacheBranching_ = true;
         }
 
         //! \name Lattice interface
@@ -70,6 +93,11 @@ namespace QuantLib {
         void initialize(DiscretizedAsset&, Time t) const;
         void rollback(DiscretizedAsset&, Time to) const;
         void partialRollback(DiscretizedAsset&, Time to) const;
+        void rollback(const std::vector<ext::shared_ptr<DiscretizedAsset> >&,
+                      Time to) const;
+        void partialRollback(
+                 const std::vector<ext::shared_ptr<DiscretizedAsset> >&,
+                 Time to) const;
         //! Computes the present value of an asset using Arrow-Debrew prices
         Real presentValue(DiscretizedAsset&) const;
         //@}
@@ -79,16 +107,40 @@ namespace QuantLib {
         void stepback(Size i,
                       const Array& values,
                       Array& newValues) const;
+        //! steps back the values of several assets stored as columns
+        void stepback(Size i,
+                      const Matrix& values,
+                      Matrix& newValues) const;
+
+        //! \name Branching cache
+        //@{
+        void enableBranchingCache();
+        void disableBranchingCache();
+        bool branchingCacheEnabled() const { return cacheBranching_; }
+        //@}
 
       protected:
         void computeStatePrices(Size until) const;
+        //! discards the stored branching of all time steps
+        void resetBranchingCache() const;
 
         // Arrow-Debrew state prices
         mutable std::vector<Array> statePrices_;
 
       private:
+        struct Branching {
+            // node j at the given step branches into nodes
+            // descendants[j*n_+l] with probabilities[j*n_+l]
+            std::vector<Size> descendants;
+            std::vector<Real> probabilities;
+            std::vector<DiscountFactor> discounts;
+        };
+        const Branching& branching(Size i) const;
+
         Size n_;
         mutable Size statePricesLimit_;
+        bool cacheBranching_;
+        mutable std::vector<Branching> branching_;
     };
 
 
@@ -152,20 +204,192 @@ namespace QuantLib {
         Integer iFrom = Integer(t_.index(from));
         Integer iTo = Integer(t_.index(to));
 
+        // the buffer holding the new values is swapped with the
+        // asset values at each step; it is only reallocated when the
+        // number of nodes changes between steps
+        Array newValues;
         for (Integer i=iFrom-1; i>=iTo; --i) {
-            Array newValues(this->impl().size(i));
+            const Size size = this->impl().size(i);
+            if (newValues.size() != size)
+                Array(size).swap(newValues);
             this->impl().stepback(i, asset.values(), newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            asset.values().swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
         }
     }
 
+    template <class Impl>
+    inline void TreeLattice<Impl>::rollback(
+                 const std::vector<ext::shared_ptr<DiscretizedAsset> >& assets,
+                 Time to) const {
+        partialRollback(assets,to);
+        for (Size k=0; k<assets.size(); ++k)
+            assets[k]->adjustValues();
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::partialRollback(
+                 const std::vector<ext::shared_ptr<DiscretizedAsset> >& assets,
+                 Time to) const {
+
+        if (assets.empty())
+            return;
+
+        Time from = assets.front()->time();
+        for (Size k=1; k<assets.size(); ++k)
+            QL_REQUIRE(close(assets[k]->time(), from),
+                       "assets at different times (" << from << " and "
+                       << assets[k]->time() << ") cannot be rolled back "
+                       "together");
+
+        if (close(from,to))
+            return;
+
+        QL_REQUIRE(from > to,
+                   "cannot roll the assets back to" << to
+                   << " (they are already at t = " << from << ")");
+
+        Integer iFrom = Integer(t_.index(from));
+        Integer iTo = Integer(t_.index(to));
+
+        const Size m = assets.size();
+        Matrix values(this->impl().size(iFrom), m), newValues;
+        for (Size k=0; k<m; ++k) {
+            const Array& v = assets[k]->values();
+            QL_REQUIRE(v.size() == values.rows(),
+                       "wrong number of values for asset #" << k);
+            for (Size j=0; j<v.size(); ++j)
+                values[j][k] = v[j];
+        }
+
+        for (Integer i=iFrom-1; i>=iTo; --i) {
+            const Size size = this->impl().size(i);
+            if (newValues.rows() != size)
+                Matrix(size, m).swap(newValues);
+            this->impl().stepback(i, values, newValues);
+            values.swap(newValues);
+
+            // the assets see their own values for the adjustments,
+            // which might modify them
+            for (Size k=0; k<m; ++k) {
+                Array& v = assets[k]->values();
+                if (v.size() != size)
+                    Array(size).swap(v);
+                for (Size j=0; j<size; ++j)
+                    v[j] = values[j][k];
+                assets[k]->time() = t_[i];
+                // skip the very last adjustment
+                if (i != iTo) {
+                    assets[k]->adjustValues();
+                    for (Size j=0; j<size; ++j)
+                        values[j][k] = v[j];
+                }
+            }
+        }
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::stepback(Size i, const Matrix& values,
+                                     Matrix& newValues) const {
+        const Size m = values.columns();
+        if (cacheBranching_) {
+            const Branching& b = branching(i);
+            #pragma omp parallel for
+            for (long j=0; j<(long)b.discounts.size(); j++) {
+                Matrix::row_iterator out = newValues.row_begin(j);
+                std::fill(out, out+m, 0.0);
+                for (Size l=0, k=j*n_; l<n_; l++, k++) {
+                    const Real p = b.probabilities[k];
+                    Matrix::const_row_iterator in =
+                        values.row_begin(b.descendants[k]);
+                    for (Size a=0; a<m; a++)
+                        out[a] += p * in[a];
+                }
+                const DiscountFactor discount = b.discounts[j];
+                for (Size a=0; a<m; a++)
+                    out[a] *= discount;
+            }
+            return;
+        }
+
+        #pragma omp parallel for
+        for (long j=0; j<(long)this->impl().size(i); j++) {
+            Matrix::row_iterator out = newValues.row_begin(j);
+            std::fill(out, out+m, 0.0);
+            for (Size l=0; l<n_; l++) {
+                const Real p = this->impl().probability(i,j,l);
+                Matrix::const_row_iterator in =
+                    values.row_begin(this->impl().descendant(i,j,l));
+                for (Size a=0; a<m; a++)
+                    out[a] += p * in[a];
+            }
+            const DiscountFactor discount = this->impl().discount(i,j);
+            for (Size a=0; a<m; a++)
+                out[a] *= discount;
+        }
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::enableBranchingCache() {
+        cacheBranching_ = true;
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::disableBranchingCache() {
+        cacheBranching_ = false;
+        resetBranchingCache();
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::resetBranchingCache() const {
+        std::vector<Branching>().swap(branching_);
+    }
+
+    template <class Impl>
+    const typename TreeLattice<Impl>::Branching&
+    TreeLattice<Impl>::branching(Size i) const {
+        if (branching_.empty())
+            branching_.resize(t_.size()-1);
+        Branching& b = branching_[i];
+        if (b.discounts.empty()) {
+            const Size size = this->impl().size(i);
+            b.descendants.resize(size*n_);
+            b.probabilities.resize(size*n_);
+            b.discounts.resize(size);
+            for (Size j=0, k=0; j<size; j++) {
+                for (Size l=0; l<n_; l++, k++) {
+                    b.descendants[k] = this->impl().descendant(i,j,l);
+                    b.probabilities[k] = this->impl().probability(i,j,l);
+                }
+                b.discounts[j] = this->impl().discount(i,j);
+            }
+        }
+        return b;
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
+        if (cacheBranching_) {
+            const Branching& b = branching(i);
+            const Size* descendants = &b.descendants[0];
+            const Real* probabilities = &b.probabilities[0];
+            const DiscountFactor* discounts = &b.discounts[0];
+            const Real* v = values.begin();
+            #pragma omp parallel for
+            for (long j=0; j<(long)b.discounts.size(); j++) {
+                const Size k = j*n_;
+                Real value = 0.0;
+                for (Size l=0; l<n_; l++)
+                    value += probabilities[k+l] * v[descendants[k+l]];
+                newValues[j] = value * discounts[j];
+            }
+            return;
+        }
+
         #pragma omp parallel for
         for (long j=0; j<(long)this->impl().size(i); j++) {
             Real value = 0.0;
@@ -31,6 +31,12 @@
 namespace QuantLib {
 
     //! calibration helper for Heston model
+    /*! If all helpers of a calibration share the same
+        AnalyticHestonEngine instance (using a Gaussian quadrature),
+        the characteristic function is evaluated only once per
+        distinct maturity at each step of the optimization and
+        reused for all strikes of that maturity.
+    */
     class HestonModelHelper : public BlackCalibrationHelper {
       public:
         HestonModelHelper(const Period& maturity,
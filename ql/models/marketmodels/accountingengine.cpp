@@ -23,6 +23,7 @@
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -35,7 +36,7 @@ namespace QuantLib {
       numberProducts_(product->numberOfProducts()),
       numerairesHeld_(product->numberOfProducts()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
-      cashFlowsGenerated_(product->numberOfProducts()) {
+      cashFlowsGenerated_(product->numberOfProducts()), pathsPerBlock_(0) {
         for (Size i=0; i<numberProducts_; ++i)
             cashFlowsGenerated_[i].resize(
                        product_->maxNumberOfCashFlowsPerProductPerStep());
@@ -50,6 +51,22 @@ namespace QuantLib {
 
     }
 
+    AccountingEngine::AccountingEngine(
+              const std::vector<ext::shared_ptr<MarketModelEvolver> >& evolvers,
+              const Clone<MarketModelMultiProduct>& product,
+              Real initialNumeraireValue,
+              Size pathsPerBlock)
+    : product_(product), initialNumeraireValue_(initialNumeraireValue),
+      numberProducts_(product->numberOfProducts()),
+      pathsPerBlock_(pathsPerBlock) {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        QL_REQUIRE(pathsPerBlock_ > 0, "null number of paths per block");
+        workers_.reserve(evolvers.size());
+        for (Size i=0; i<evolvers.size(); ++i)
+            workers_.push_back(ext::make_shared<AccountingEngine>(
+                                 evolvers[i], product, initialNumeraireValue));
+    }
+
     Real AccountingEngine::singlePathValues(std::vector<Real>& values) {
         std::fill(numerairesHeld_.begin(), numerairesHeld_.end(), 0.0);
         Real weight = evolver_->startNewPath();
@@ -115,6 +132,11 @@ namespace QuantLib {
     void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
                                               Size numberOfPaths)
     {
+        if (!workers_.empty()) {
+            parallelPathValues(stats, numberOfPaths);
+            return;
+        }
+
         std::vector<Real> values(product_->numberOfProducts());
         for (Size i=0; i<numberOfPaths; ++i) {
             Real weight = singlePathValues(values);
@@ -122,4 +144,40 @@ namespace QuantLib {
         }
     }
 
+    void AccountingEngine::parallelPathValues(SequenceStatisticsInc& stats,
+                                              Size numberOfPaths) {
+        const Size nWorkers = workers_.size();
+        Matrix values(nWorkers*pathsPerBlock_, numberProducts_);
+        std::vector<Real> weights(nWorkers*pathsPerBlock_);
+        std::vector<std::string> errors(nWorkers);
+
+        for (Size done=0; done<numberOfPaths; ) {
+            // each worker simulates a block of paths...
+            const Size paths = std::min(nWorkers*pathsPerBlock_,
+                                        numberOfPaths-done);
+            #pragma omp parallel for
+            for (long w=0; w<long(nWorkers); ++w) {
+                const Size begin = Size(w)*pathsPerBlock_;
+                const Size end = std::min(begin+pathsPerBlock_, paths);
+                try {
+                    std::vector<Real> pathValues(numberProducts_);
+                    for (Size i=begin; i<end; ++i) {
+                        weights[i] = workers_[w]->singlePathValues(pathValues);
+                        std::copy(pathValues.begin(), pathValues.end(),
+                                  values.row_begin(i));
+                    }
+                } catch (std::exception& e) {
+                    errors[w] = e.what();
+                }
+            }
+            for (Size w=0; w<nWorkers; ++w)
+                QL_REQUIRE(errors[w].empty(), errors[w]);
+
+            // ...and the results are collected in order
+            for (Size i=0; i<paths; ++i)
+                stats.add(values.row_begin(i), values.row_end(i), weights[i]);
+            done += paths;
+        }
+    }
+
 }
@@ -41,15 +41,32 @@ namespace QuantLib {
     //struct MarketModelMultiProduct::CashFlow;
 
     //! Engine collecting cash flows along a market-model simulation
+    /*! When several evolvers are given, each of them drives its own
+        copy of the product and the paths are simulated in parallel
+        if OpenMP is enabled.  The paths are assigned to the evolvers
+        in blocks of fixed size and added to the statistics in a
+        fixed order, so that the results do not depend on the number
+        of threads.
+
+        \pre the evolvers must use independent Brownian generators,
+             e.g., Mersenne-twister generators with different seeds.
+    */
     class AccountingEngine {
       public:
         AccountingEngine(const ext::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
                          Real initialNumeraireValue);
+        AccountingEngine(
+              const std::vector<ext::shared_ptr<MarketModelEvolver> >& evolvers,
+              const Clone<MarketModelMultiProduct>& product,
+              Real initialNumeraireValue,
+              Size pathsPerBlock = 256);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
         Real singlePathValues(std::vector<Real>& values);
+        void parallelPathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
 
         ext::shared_ptr<MarketModelEvolver> evolver_;
         Clone<MarketModelMultiProduct> product_;
@@ -64,6 +81,9 @@ namespace QuantLib {
                                                          cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
 
+        // one engine per evolver for parallel simulations
+        std::vector<ext::shared_ptr<AccountingEngine> > workers_;
+        Size pathsPerBlock_;
     };
 
 }
@@ -30,6 +30,7 @@
 #include <ql/models/marketmodels/callability/exercisevalue.hpp>
 #include <ql/auto_ptr.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -120,7 +121,7 @@ namespace QuantLib {
                    Real initialNumeraireValue)
     : evolver_(evolver), innerEvolvers_(innerEvolvers),
       composite_(MultiProductComposite()),
-      initialNumeraireValue_(initialNumeraireValue) {
+      initialNumeraireValue_(initialNumeraireValue), pathsPerBlock_(0) {
 
         composite_.add(underlying);
         composite_.add(ExerciseAdapter(rebate));
@@ -168,18 +169,81 @@ namespace QuantLib {
     }
 
 
+    UpperBoundEngine::UpperBoundEngine(
+            const std::vector<ext::shared_ptr<MarketModelEvolver> >& evolvers,
+            const std::vector<std::vector<
+                         ext::shared_ptr<MarketModelEvolver> > >& innerEvolvers,
+            const MarketModelMultiProduct& underlying,
+            const MarketModelExerciseValue& rebate,
+            const MarketModelMultiProduct& hedge,
+            const MarketModelExerciseValue& hedgeRebate,
+            const ExerciseStrategy<CurveState>& hedgeStrategy,
+            Real initialNumeraireValue,
+            Size pathsPerBlock)
+    : initialNumeraireValue_(initialNumeraireValue),
+      pathsPerBlock_(pathsPerBlock) {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        QL_REQUIRE(innerEvolvers.size() == evolvers.size(),
+                   "number of inner-evolver sets (" << innerEvolvers.size()
+                   << ") different from number of evolvers ("
+                   << evolvers.size() << ")");
+        QL_REQUIRE(pathsPerBlock_ > 0, "null number of paths per block");
+        workers_.reserve(evolvers.size());
+        for (Size i=0; i<evolvers.size(); ++i)
+            workers_.push_back(ext::make_shared<UpperBoundEngine>(
+                                         evolvers[i], innerEvolvers[i],
+                                         underlying, rebate,
+                                         hedge, hedgeRebate, hedgeStrategy,
+                                         initialNumeraireValue));
+    }
+
+
     void UpperBoundEngine::multiplePathValues(Statistics& stats,
                                               Size outerPaths,
                                               Size innerPaths) {
-        for (Size i=0; i<outerPaths; ++i) {
-            std::pair<Real,Real> result = singlePathValue(innerPaths);
-            stats.add(result.first, result.second);
+        if (workers_.empty()) {
+            for (Size i=0; i<outerPaths; ++i) {
+                std::pair<Real,Real> result = singlePathValue(innerPaths);
+                stats.add(result.first, result.second);
+            }
+            return;
+        }
+
+        const Size nWorkers = workers_.size();
+        std::vector<std::pair<Real,Real> > results(nWorkers*pathsPerBlock_);
+        std::vector<std::string> errors(nWorkers);
+
+        for (Size done=0; done<outerPaths; ) {
+            // each worker simulates a block of paths...
+            const Size paths = std::min(nWorkers*pathsPerBlock_,
+                                        outerPaths-done);
+            #pragma omp parallel for schedule(dynamic)
+            for (long w=0; w<long(nWorkers); ++w) {
+                const Size begin = Size(w)*pathsPerBlock_;
+                const Size end = std::min(begin+pathsPerBlock_, paths);
+                try {
+                    for (Size i=begin; i<end; ++i)
+                        results[i] = workers_[w]->singlePathValue(innerPaths);
+                } catch (std::exception& e) {
+                    errors[w] = e.what();
+                }
+            }
+            for (Size w=0; w<nWorkers; ++w)
+                QL_REQUIRE(errors[w].empty(), errors[w]);
+
+            // ...and the results are collected in order
+            for (Size i=0; i<paths; ++i)
+                stats.add(results[i].first, results[i].second);
+            done += paths;
         }
     }
 
 
     std::pair<Real,Real> UpperBoundEngine::singlePathValue(Size innerPaths) {
 
+        if (!workers_.empty())
+            return workers_.front()->singlePathValue(innerPaths);
+
         DecoratedHedge& callable =
             dynamic_cast<DecoratedHedge&>(composite_.item(4));
         const ExerciseStrategy<CurveState>& strategy = callable.strategy();
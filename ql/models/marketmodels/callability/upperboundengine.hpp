@@ -37,8 +37,17 @@ namespace QuantLib {
     class MarketModelExerciseValue;
 
     //! Market-model %engine for upper-bound estimation
-    /*! \pre product and hedge must have the same rate times
+    /*! When several sets of evolvers are given, the outer paths
+        are simulated in parallel if OpenMP is enabled, each set of
+        evolvers driving its own copies of the products.  The paths
+        are assigned to the sets in blocks of fixed size and added to
+        the statistics in a fixed order, so that the results do not
+        depend on the number of threads.
+
+        \pre product and hedge must have the same rate times
              and exercise times
+        \pre when simulating in parallel, all evolvers must use
+             independent Brownian generators.
     */
     class UpperBoundEngine {
       public:
@@ -52,6 +61,19 @@ namespace QuantLib {
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
                    Real initialNumeraireValue);
+        /*! evolvers[i] and innerEvolvers[i] are the outer and inner
+            evolvers used by the i-th set */
+        UpperBoundEngine(
+            const std::vector<ext::shared_ptr<MarketModelEvolver> >& evolvers,
+            const std::vector<std::vector<
+                         ext::shared_ptr<MarketModelEvolver> > >& innerEvolvers,
+            const MarketModelMultiProduct& underlying,
+            const MarketModelExerciseValue& rebate,
+            const MarketModelMultiProduct& hedge,
+            const MarketModelExerciseValue& hedgeRebate,
+            const ExerciseStrategy<CurveState>& hedgeStrategy,
+            Real initialNumeraireValue,
+            Size pathsPerBlock = 8);
         void multiplePathValues(Statistics& stats,
                                 Size outerPaths,
                                 Size innerPaths);
@@ -78,6 +100,9 @@ namespace QuantLib {
         std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
                                                          cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
+        // one engine per set of evolvers for parallel simulations
+        std::vector<ext::shared_ptr<UpperBoundEngine> > workers_;
+        Size pathsPerBlock_;
     };
 
 }
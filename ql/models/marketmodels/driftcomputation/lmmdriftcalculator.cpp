@@ -181,4 +181,111 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::compute(const Matrix& fwds,
+                                     Matrix& drifts) const {
+        QL_REQUIRE(fwds.rows()==numberOfRates_,
+                   "forwards rows (" << fwds.rows()
+                   << ") <> number of rates (" << numberOfRates_ << ")");
+        QL_REQUIRE(drifts.rows()==numberOfRates_ &&
+                   drifts.columns()==fwds.columns(),
+                   "drifts size (" << drifts.rows() << "x"
+                   << drifts.columns() << ") <> forwards size ("
+                   << fwds.rows() << "x" << fwds.columns() << ")");
+
+        // paths are processed in chunks small enough for their
+        // workspace to stay in cache
+        const Size chunkSize = 64;
+        const long nChunks = long((fwds.columns()+chunkSize-1)/chunkSize);
+
+        #pragma omp parallel for if(nChunks > 1)
+        for (long k=0; k<nChunks; ++k) {
+            const Size begin = Size(k)*chunkSize;
+            const Size end = std::min(begin+chunkSize, fwds.columns());
+            if (isFullFactor_)
+                computePlain(fwds, drifts, begin, end);
+            else
+                computeReduced(fwds, drifts, begin, end);
+        }
+    }
+
+    void LMMDriftCalculator::computePlain(const Matrix& fwds,
+                                          Matrix& drifts,
+                                          Size begin, Size end) const {
+        const Size n = end-begin;
+
+        Matrix tmp(numberOfRates_, n);
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = fwds.row_begin(i) + begin;
+            Real* t = tmp.row_begin(i);
+            for (Size p=0; p<n; ++p)
+                t[p] = (f[p]+displacements_[i]) / (oneOverTaus_[i]+f[p]);
+        }
+
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Real* d = drifts.row_begin(i) + begin;
+            std::fill(d, d+n, 0.0);
+            for (Size j=downs_[i]; j<ups_[i]; ++j) {
+                const Real c = C_[i][j];
+                const Real* t = tmp.row_begin(j);
+                for (Size p=0; p<n; ++p)
+                    d[p] += t[p]*c;
+            }
+            if (numeraire_>i+1) {
+                for (Size p=0; p<n; ++p)
+                    d[p] = -d[p];
+            }
+        }
+    }
+
+    void LMMDriftCalculator::computeReduced(const Matrix& fwds,
+                                            Matrix& drifts,
+                                            Size begin, Size end) const {
+        const Size n = end-begin;
+
+        // same algorithm as the single-path version; e holds the
+        // partial sums of the current rate for each factor and path
+        Matrix tmp(numberOfRates_, n), e(numberOfFactors_, n, 0.0);
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = fwds.row_begin(i) + begin;
+            Real* t = tmp.row_begin(i);
+            for (Size p=0; p<n; ++p)
+                t[p] = (f[p]+displacements_[i]) / (oneOverTaus_[i]+f[p]);
+        }
+
+        if (numeraire_>0) {
+            Real* d = drifts.row_begin(numeraire_-1) + begin;
+            std::fill(d, d+n, 0.0);
+        }
+
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Real* d = drifts.row_begin(i) + begin;
+            std::fill(d, d+n, 0.0);
+            const Real* t = tmp.row_begin(i+1);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real a1 = pseudo_[i+1][r], a = pseudo_[i][r];
+                Real* er = e.row_begin(r);
+                for (Size p=0; p<n; ++p) {
+                    er[p] += t[p] * a1;
+                    d[p] -= er[p]*a;
+                }
+            }
+        }
+
+        std::fill(e.begin(), e.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Real* d = drifts.row_begin(i) + begin;
+            std::fill(d, d+n, 0.0);
+            const Real* t = tmp.row_begin(i);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real a = pseudo_[i][r];
+                Real* er = e.row_begin(r);
+                for (Size p=0; p<n; ++p) {
+                    er[p] += t[p] * a;
+                    d[p] += er[p]*a;
+                }
+            }
+        }
+    }
+
 }
@@ -64,7 +64,19 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! Computes the drifts for a batch of paths.  Forwards and
+            drifts are stored with one row per rate and one column
+            per path, so that the innermost loops run over paths on
+            contiguous memory; the paths are split among threads if
+            OpenMP is enabled.  Drifts of expired rates are not
+            modified. */
+        void compute(const Matrix& fwds, Matrix& drifts) const;
+
       private:
+        void computePlain(const Matrix& fwds, Matrix& drifts,
+                          Size begin, Size end) const;
+        void computeReduced(const Matrix& fwds, Matrix& drifts,
+                            Size begin, Size end) const;
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
         Size numeraire_, alive_;
@@ -0,0 +1,214 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/lognormalfwdratebatchpc.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+
+namespace QuantLib {
+
+    LogNormalFwdRateBatchPc::LogNormalFwdRateBatchPc(
+                           const ext::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep,
+                           Size batchSize)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      initialStep_(initialStep), batchSize_(batchSize),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel_->numberOfFactors()),
+      numberOfSteps_(marketModel->evolution().numberOfSteps()),
+      curveState_(marketModel->evolution().rateTimes()),
+      currentStep_(initialStep), currentPath_(batchSize),
+      displacements_(marketModel->displacements()),
+      initialForwards_(numberOfRates_), initialLogForwards_(numberOfRates_),
+      forwards_(numberOfRates_), brownians_(numberOfFactors_),
+      alive_(marketModel->evolution().firstAliveRate()),
+      pathWeights_(batchSize),
+      logForwards_(numberOfRates_, batchSize),
+      currentForwards_(numberOfRates_, batchSize),
+      drifts1_(numberOfRates_, batchSize),
+      drifts2_(numberOfRates_, batchSize)
+    {
+        checkCompatibility(marketModel->evolution(), numeraires);
+        QL_REQUIRE(batchSize_ > 0, "null batch size given");
+        QL_REQUIRE(initialStep_ < numberOfSteps_,
+                   "initial step (" << initialStep_
+                   << ") beyond the last step");
+
+        const Size evolvedSteps = numberOfSteps_-initialStep_;
+        generator_ = factory.create(numberOfFactors_, evolvedSteps);
+
+        batchForwards_ = std::vector<Matrix>(
+                              evolvedSteps, Matrix(numberOfRates_, batchSize_));
+        batchBrownians_ = std::vector<Matrix>(
+                            evolvedSteps, Matrix(numberOfFactors_, batchSize_));
+        stepWeights_ = Matrix(evolvedSteps, batchSize_);
+
+        calculators_.reserve(numberOfSteps_);
+        fixedDrifts_.reserve(numberOfSteps_);
+        for (Size j=0; j<numberOfSteps_; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.push_back(
+                LMMDriftCalculator(A,
+                                   displacements_,
+                                   marketModel->evolution().rateTaus(),
+                                   numeraires[j],
+                                   alive_[j]));
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), 0.0);
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        setForwards(marketModel_->initialRates());
+    }
+
+    const std::vector<Size>& LogNormalFwdRateBatchPc::numeraires() const {
+        return numeraires_;
+    }
+
+    void LogNormalFwdRateBatchPc::setForwards(
+                                        const std::vector<Real>& forwards) {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        for (Size i=0; i<numberOfRates_; ++i) {
+            initialForwards_[i] = forwards[i];
+            initialLogForwards_[i] = std::log(forwards[i] +
+                                              displacements_[i]);
+        }
+        // paths already evolved started from the old forwards
+        currentPath_ = batchSize_;
+    }
+
+    void LogNormalFwdRateBatchPc::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+    }
+
+    Real LogNormalFwdRateBatchPc::startNewPath() {
+        currentStep_ = initialStep_;
+        if (currentPath_+1 < batchSize_) {
+            ++currentPath_;
+        } else {
+            evolveBatch();
+            currentPath_ = 0;
+        }
+        return pathWeights_[currentPath_];
+    }
+
+    Real LogNormalFwdRateBatchPc::advanceStep() {
+        const Size k = currentStep_-initialStep_;
+        QL_REQUIRE(currentStep_ < numberOfSteps_, "no more steps to evolve");
+
+        std::copy(batchForwards_[k].column_begin(currentPath_),
+                  batchForwards_[k].column_end(currentPath_),
+                  forwards_.begin());
+        curveState_.setOnForwardRates(forwards_);
+
+        ++currentStep_;
+
+        return stepWeights_[k][currentPath_];
+    }
+
+    Size LogNormalFwdRateBatchPc::currentStep() const {
+        return currentStep_;
+    }
+
+    const CurveState& LogNormalFwdRateBatchPc::currentState() const {
+        return curveState_;
+    }
+
+    void LogNormalFwdRateBatchPc::evolveBatch() {
+        const Size evolvedSteps = numberOfSteps_-initialStep_;
+
+        // draw the increments in the same order as the path-wise
+        // evolvers, so that the same paths are generated
+        for (Size p=0; p<batchSize_; ++p) {
+            pathWeights_[p] = generator_->nextPath();
+            for (Size k=0; k<evolvedSteps; ++k) {
+                stepWeights_[k][p] = generator_->nextStep(brownians_);
+                for (Size f=0; f<numberOfFactors_; ++f)
+                    batchBrownians_[k][f][p] = brownians_[f];
+            }
+        }
+
+        for (Size i=0; i<numberOfRates_; ++i) {
+            std::fill(logForwards_.row_begin(i), logForwards_.row_end(i),
+                      initialLogForwards_[i]);
+            std::fill(currentForwards_.row_begin(i),
+                      currentForwards_.row_end(i), initialForwards_[i]);
+        }
+
+        const long n = long(numberOfRates_);
+        for (Size k=0; k<evolvedSteps; ++k) {
+            const Size step = initialStep_+k;
+            const Matrix& A = marketModel_->pseudoRoot(step);
+            const Matrix& Z = batchBrownians_[k];
+            const std::vector<Real>& fixedDrift = fixedDrifts_[step];
+            const long alive = long(alive_[step]);
+
+            // a) compute drifts D1 at T1;
+            calculators_[step].compute(currentForwards_, drifts1_);
+
+            // b) evolve forwards up to T2 using D1;
+            #pragma omp parallel for
+            for (long i=alive; i<n; ++i) {
+                Real* x = logForwards_.row_begin(i);
+                Real* f = currentForwards_.row_begin(i);
+                const Real* d1 = drifts1_.row_begin(i);
+                std::vector<Real> diffusion(batchSize_, 0.0);
+                for (Size j=0; j<numberOfFactors_; ++j) {
+                    const Real a = A[i][j];
+                    const Real* z = Z.row_begin(j);
+                    for (Size p=0; p<batchSize_; ++p)
+                        diffusion[p] += a*z[p];
+                }
+                for (Size p=0; p<batchSize_; ++p) {
+                    x[p] += d1[p] + fixedDrift[i];
+                    x[p] += diffusion[p];
+                    f[p] = std::exp(x[p]) - displacements_[i];
+                }
+            }
+
+            // c) recompute drifts D2 using the predicted forwards;
+            calculators_[step].compute(currentForwards_, drifts2_);
+
+            // d) correct forwards using both drifts
+            #pragma omp parallel for
+            for (long i=alive; i<n; ++i) {
+                Real* x = logForwards_.row_begin(i);
+                Real* f = currentForwards_.row_begin(i);
+                const Real* d1 = drifts1_.row_begin(i);
+                const Real* d2 = drifts2_.row_begin(i);
+                for (Size p=0; p<batchSize_; ++p) {
+                    x[p] += (d2[p]-d1[p])/2.0;
+                    f[p] = std::exp(x[p]) - displacements_[i];
+                }
+            }
+
+            std::copy(currentForwards_.begin(), currentForwards_.end(),
+                      batchForwards_[k].begin());
+        }
+    }
+
+}
@@ -0,0 +1,102 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lognormalfwdratebatchpc.hpp
+    \brief predictor-corrector evolving batches of paths in lock-step
+*/
+
+#ifndef quantlib_forward_rate_batch_pc_evolver_hpp
+#define quantlib_forward_rate_batch_pc_evolver_hpp
+
+#include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+
+    //! Predictor-Corrector evolving batches of paths
+    /*! Same discretization as LogNormalFwdRatePc, but the paths are
+        evolved in batches: when a new batch is needed, the Brownian
+        increments of all its paths are drawn (in the same order as
+        LogNormalFwdRatePc would draw them) and all the paths are
+        evolved in lock-step over all the steps.  Forwards and drifts
+        are stored as (rates x paths) matrices, so that the drifts are
+        computed by LMMDriftCalculator on contiguous data for the
+        whole batch; the work is shared among threads if OpenMP is
+        enabled.  startNewPath() and advanceStep() then just return
+        the stored states, so the class can replace
+        LogNormalFwdRatePc in the accounting engines.
+
+        \warning all the steps of each path in the batch are
+                 evolved, even if the product terminates earlier.
+                 For products terminating before the last step, the
+                 results therefore differ from those obtained with
+                 LogNormalFwdRatePc by the use of different random
+                 numbers.
+    */
+    class LogNormalFwdRateBatchPc : public MarketModelEvolver {
+      public:
+        LogNormalFwdRateBatchPc(const ext::shared_ptr<MarketModel>&,
+                                const BrownianGeneratorFactory&,
+                                const std::vector<Size>& numeraires,
+                                Size initialStep = 0,
+                                Size batchSize = 256);
+        //! \name MarketModel interface
+        //@{
+        const std::vector<Size>& numeraires() const;
+        Real startNewPath();
+        Real advanceStep();
+        Size currentStep() const;
+        const CurveState& currentState() const;
+        void setInitialState(const CurveState&);
+        //@}
+      private:
+        void setForwards(const std::vector<Real>& forwards);
+        void evolveBatch();
+        // inputs
+        ext::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_, batchSize_;
+        ext::shared_ptr<BrownianGenerator> generator_;
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_, numberOfSteps_;
+        LMMCurveState curveState_;
+        Size currentStep_, currentPath_;
+        std::vector<Rate> displacements_;
+        std::vector<Rate> initialForwards_, initialLogForwards_;
+        std::vector<Rate> forwards_;
+        std::vector<Real> brownians_;
+        std::vector<Size> alive_;
+        // batch storage: one (rates x paths) matrix of forwards and
+        // one (factors x paths) matrix of increments per step
+        std::vector<Matrix> batchForwards_, batchBrownians_;
+        std::vector<Real> pathWeights_;
+        Matrix stepWeights_;
+        Matrix logForwards_, currentForwards_, drifts1_, drifts2_;
+        // helper classes
+        std::vector<LMMDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
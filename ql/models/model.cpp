@@ -23,6 +23,7 @@
 #include <ql/math/optimization/projection.hpp>
 #include <ql/math/optimization/projectedconstraint.hpp>
 #include <ql/utilities/null_deleter.hpp>
+#include <string>
 
 using std::vector;
 
@@ -31,24 +32,29 @@ namespace QuantLib {
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None),
+      parallelCalibration_(false) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
         CalibrationFunction(CalibratedModel* model,
                             const vector<ext::shared_ptr<CalibrationHelperBase> >& h,
                             const vector<Real>& weights,
-                            const Projection& projection)
+                            const Projection& projection,
+                            bool parallel = false)
             : model_(model, null_deleter()), instruments_(h),
-              weights_(weights), projection_(projection) {}
+              weights_(weights), projection_(projection),
+              parallel_(parallel) {}
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(projection_.include(params));
+            Array errors(instruments_.size());
+            calibrationErrors(errors);
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
+                Real diff = errors[i];
                 value += diff*diff*weights_[i];
             }
             return std::sqrt(value);
@@ -57,9 +63,9 @@ namespace QuantLib {
         virtual Disposable<Array> values(const Array& params) const {
             model_->setParams(projection_.include(params));
             Array values(instruments_.size());
+            calibrationErrors(values);
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] *= std::sqrt(weights_[i]);
             }
             return values;
         }
@@ -67,10 +73,40 @@ namespace QuantLib {
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        void calibrationErrors(Array& errors) const {
+            Size n = instruments_.size();
+            if (!parallel_ || n < 2) {
+                for (Size i=0; i<n; i++)
+                    errors[i] = instruments_[i]->calibrationError();
+                return;
+            }
+
+            // lazy objects are not thread safe. The first helper is
+            // evaluated outside the parallel loop, so that anything
+            // shared by all helpers (e.g. term structures or cached
+            // model quantities) is recalculated before the threads
+            // start.
+            errors[0] = instruments_[0]->calibrationError();
+
+            // exceptions must not escape the parallel region
+            std::string error;
+            #pragma omp parallel for
+            for (long i=1; i<(long)n; i++) {
+                try {
+                    errors[i] = instruments_[i]->calibrationError();
+                } catch (std::exception& e) {
+                    #pragma omp critical(ql_calibration_error)
+                    error = e.what();
+                }
+            }
+            QL_REQUIRE(error.empty(), error);
+        }
+
         ext::shared_ptr<CalibratedModel> model_;
         const vector<ext::shared_ptr<CalibrationHelperBase> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        bool parallel_;
     };
 
     void CalibratedModel::calibrate(
@@ -117,7 +153,7 @@ namespace QuantLib {
                    fixParameters.size() << ")");
         vector<bool> all(prms.size(), false);
         Projection proj(prms,fixParameters.size()>0 ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+        CalibrationFunction f(this,instruments,w,proj,parallelCalibration_);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
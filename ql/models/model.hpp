@@ -134,6 +134,21 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        //! Evaluates the calibration helpers concurrently
+        /*! When enabled and the library is compiled with OpenMP
+            support, the calibration errors of the helpers are
+            evaluated in parallel at each cost-function evaluation.
+
+            \warning each helper must be given its own pricing-engine
+                     instance, since engines are not thread safe;
+                     helpers sharing an engine must be calibrated
+                     sequentially.
+        */
+        void setParallelCalibration(bool flag) {
+            parallelCalibration_ = flag;
+        }
+        bool parallelCalibration() const { return parallelCalibration_; }
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -141,6 +156,7 @@ namespace QuantLib {
         EndCriteria::Type shortRateEndCriteria_;
         Array problemValues_;
         Integer functionEvaluation_;
+        bool parallelCalibration_;
 
       private:
         //! Constraint imposed on arguments
@@ -106,6 +106,7 @@ namespace QuantLib {
         void setSpread(Spread spread)
         {
             spread_=spread;
+            resetBranchingCache();
         }
       private:
         ext::shared_ptr<TrinomialTree> tree_;
@@ -282,4 +282,77 @@ const Disposable<Array> Gaussian1dModel::yGrid(const Real stdDevs,
 
     return result;
 }
+
+const Disposable<Array>
+Gaussian1dModel::zerobondGrid(const Time T, const Time t, const Real yStdDevs,
+                              const int gridPoints,
+                              const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    if (!cacheStateGrids_) {
+        Array z = yGrid(yStdDevs, gridPoints);
+        Array result(z.size());
+        for (Size i = 0; i < z.size(); i++)
+            result[i] = zerobond(T, t, z[i], yts);
+        return result;
+    }
+
+    StateGridKey k = {T, t, yStdDevs, gridPoints};
+    StateGridCacheType::iterator i = zerobondGrids_.find(k);
+    if (i == zerobondGrids_.end()) {
+        Array z = yGrid(yStdDevs, gridPoints);
+        Array grid(z.size());
+        for (Size j = 0; j < z.size(); j++)
+            grid[j] = zerobond(T, t, z[j]);
+        i = zerobondGrids_.insert(std::make_pair(k, grid)).first;
+    }
+
+    Array result = i->second;
+    if (!yts.empty())
+        result *= zerobond(T, t, 0.0, yts) / zerobond(T, t, 0.0);
+    return result;
+}
+
+const Disposable<Array>
+Gaussian1dModel::numeraireGrid(const Time t, const Real yStdDevs,
+                               const int gridPoints,
+                               const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    if (!cacheStateGrids_) {
+        Array z = yGrid(yStdDevs, gridPoints);
+        Array result(z.size());
+        for (Size i = 0; i < z.size(); i++)
+            result[i] = numeraire(t, z[i], yts);
+        return result;
+    }
+
+    StateGridKey k = {t, t, yStdDevs, gridPoints};
+    StateGridCacheType::iterator i = numeraireGrids_.find(k);
+    if (i == numeraireGrids_.end()) {
+        Array z = yGrid(yStdDevs, gridPoints);
+        Array grid(z.size());
+        for (Size j = 0; j < z.size(); j++)
+            grid[j] = numeraire(t, z[j]);
+        i = numeraireGrids_.insert(std::make_pair(k, grid)).first;
+    }
+
+    Array result = i->second;
+    if (!yts.empty())
+        result *= numeraire(t, 0.0, yts) / numeraire(t, 0.0);
+    return result;
+}
+
+void Gaussian1dModel::enableStateGridCache(bool enable) {
+    cacheStateGrids_ = enable;
+    if (!enable)
+        clearStateGridCache();
+}
+
+void Gaussian1dModel::clearStateGridCache() const {
+    zerobondGrids_.clear();
+    numeraireGrids_.clear();
+}
 }
@@ -148,6 +148,40 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
                                   const Real T = 1.0, const Real t = 0,
                                   const Real y = 0) const;
 
+    /*! Returns the zerobond prices \f$ P(t,T) \f$ for all points of
+        the grid yGrid(yStdDevs, gridPoints) of the standardized state
+        variable at time $t$.
+
+        Grids are computed on the model curve and cached by
+        $(T, t)$, so that they are shared by all engines and
+        instruments using the model; the cache is cleared whenever the
+        model is recalculated or its parameters change.  Grids for a
+        different curve are obtained by rescaling with the ratio of
+        the prices at $y=0$, which requires this ratio not to depend
+        on the state (as is the case for the Gsr and MarkovFunctional
+        models).
+
+        \warning the cache is not thread safe; grids must be retrieved
+                 before entering a parallel region.
+    */
+    const Disposable<Array> zerobondGrid(
+        const Time T, const Time t, const Real yStdDevs, const int gridPoints,
+        const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
+
+    //! numeraire values at time $t$ on the grid yGrid(yStdDevs, gridPoints)
+    /*! See zerobondGrid() for details on the caching. */
+    const Disposable<Array> numeraireGrid(
+        const Time t, const Real yStdDevs, const int gridPoints,
+        const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
+
+    /*! Grids are cached by default; disabling the cache releases the
+        stored grids, e.g. for large books of instruments sharing
+        few dates.
+    */
+    void enableStateGridCache(bool enable = true);
+    bool stateGridCacheEnabled() const { return cacheStateGrids_; }
+    void clearStateGridCache() const;
+
   private:
     // It is of great importance for performance reasons to cache underlying
     // swaps generated from indexes. In addition the indexes may only be given
@@ -180,10 +214,40 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
 
     mutable CacheType swapCache_;
 
+    // state grids of zerobond and numeraire values, see zerobondGrid()
+
+    struct StateGridKey {
+        Time T, t;
+        Real yStdDevs;
+        int gridPoints;
+        bool operator==(const StateGridKey &o) const {
+            return T == o.T && t == o.t && yStdDevs == o.yStdDevs &&
+                   gridPoints == o.gridPoints;
+        }
+    };
+
+    struct StateGridKeyHasher {
+        std::size_t operator()(StateGridKey const &x) const {
+            std::size_t seed = 0;
+            boost::hash_combine(seed, x.T);
+            boost::hash_combine(seed, x.t);
+            boost::hash_combine(seed, x.yStdDevs);
+            boost::hash_combine(seed, x.gridPoints);
+            return seed;
+        }
+    };
+
+    typedef boost::unordered_map<StateGridKey, Array, StateGridKeyHasher>
+        StateGridCacheType;
+
+    mutable StateGridCacheType zerobondGrids_, numeraireGrids_;
+    bool cacheStateGrids_;
+
   protected:
     // we let derived classes register with the termstructure
     Gaussian1dModel(const Handle<YieldTermStructure> &yieldTermStructure)
-        : TermStructureConsistentModel(yieldTermStructure) {
+        : TermStructureConsistentModel(yieldTermStructure),
+          cacheStateGrids_(true) {
         registerWith(Settings::instance().evaluationDate());
     }
 
@@ -200,9 +264,11 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
         evaluationDate_ = Settings::instance().evaluationDate();
         enforcesTodaysHistoricFixings_ =
             Settings::instance().enforcesTodaysHistoricFixings();
+        clearStateGridCache();
     }
 
     void generateArguments() {
+        clearStateGridCache();
         calculate();
         notifyObservers();
     }
@@ -379,6 +379,7 @@ namespace QuantLib {
             // hard to avoid though.
             calculate();
             updateNumeraireTabulation();
+            clearStateGridCache();
             notifyObservers();
         }
 
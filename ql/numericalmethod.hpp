@@ -27,6 +27,7 @@
 
 #include <ql/timegrid.hpp>
 #include <ql/math/array.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -86,6 +87,24 @@ namespace QuantLib {
         //! computes the present value of an asset.
         virtual Real presentValue(DiscretizedAsset&) const = 0;
 
+        /*! Roll back a set of assets, initialized at the same time,
+            until the given time, performing any needed adjustment.
+            The default implementation rolls back each asset in turn;
+            derived classes can override it to share the backward
+            induction between the assets.
+        */
+        virtual void rollback(
+                 const std::vector<ext::shared_ptr<DiscretizedAsset> >&,
+                 Time to) const;
+
+        /*! Roll back a set of assets, initialized at the same time,
+            until the given time, but do not perform the final
+            adjustment.
+        */
+        virtual void partialRollback(
+                 const std::vector<ext::shared_ptr<DiscretizedAsset> >&,
+                 Time to) const;
+
         //@}
 
         // this is a smell, but we need it. We'll rethink it later.
@@ -21,6 +21,7 @@
 
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/exercise.hpp>
+#include <ql/settings.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmdividendhandler.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
@@ -42,13 +43,62 @@ namespace QuantLib {
             bool localVol, Real illegalLocalVolOverwrite)
     : process_(process), tGrid_(tGrid), xGrid_(xGrid),
       dampingSteps_(dampingSteps), schemeDesc_(schemeDesc),
-      localVol_(localVol), illegalLocalVolOverwrite_(illegalLocalVolOverwrite){
+      localVol_(localVol), illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      spotTolerance_(Null<Real>()), marketChanged_(true),
+      cachedSpot_(Null<Real>()) {
 
         registerWith(process_);
     }
 
+    void FdBlackScholesBarrierEngine::enableSpotShiftCaching(Real tolerance) {
+        QL_REQUIRE(tolerance >= 0.0,
+                   "negative spot tolerance (" << tolerance << ") given");
+        spotTolerance_ = tolerance;
+
+        if (!marketObserver_) {
+            marketObserver_ = ext::make_shared<MarketObserver>(&marketChanged_);
+            marketObserver_->registerWith(process_->riskFreeRate());
+            marketObserver_->registerWith(process_->dividendYield());
+            marketObserver_->registerWith(process_->blackVolatility());
+            marketObserver_->registerWith(
+                                   Settings::instance().evaluationDate());
+        }
+        cachedSolver_.reset();
+    }
+
+    void FdBlackScholesBarrierEngine::disableSpotShiftCaching() {
+        spotTolerance_ = Null<Real>();
+        marketObserver_.reset();
+        cachedSolver_.reset();
+    }
+
     void FdBlackScholesBarrierEngine::calculate() const {
 
+        const Real spot = process_->x0();
+        const bool caching = spotTolerance_ != Null<Real>() && !localVol_
+            && (   arguments_.barrierType == Barrier::DownOut
+                || arguments_.barrierType == Barrier::UpOut);
+
+        // the spot must also stay on the alive side of the barrier,
+        // where the mesh ends
+        const bool alive = (arguments_.barrierType == Barrier::DownOut)
+            ? spot > arguments_.barrier : spot < arguments_.barrier;
+
+        if (caching && alive && cachedSolver_ && !marketChanged_
+            && std::fabs(std::log(spot/cachedSpot_)) <= spotTolerance_
+            && arguments_.payoff == cachedArguments_.payoff
+            && arguments_.exercise == cachedArguments_.exercise
+            && arguments_.cashFlow == cachedArguments_.cashFlow
+            && arguments_.barrierType == cachedArguments_.barrierType
+            && arguments_.barrier == cachedArguments_.barrier
+            && arguments_.rebate == cachedArguments_.rebate) {
+            results_.value = cachedSolver_->valueAt(spot);
+            results_.delta = cachedSolver_->deltaAt(spot);
+            results_.gamma = cachedSolver_->gammaAt(spot);
+            results_.theta = cachedSolver_->thetaAt(spot);
+            return;
+        }
+
         // 1. Mesher
         const ext::shared_ptr<StrikedTypePayoff> payoff =
             ext::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
@@ -121,18 +171,26 @@ namespace QuantLib {
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
                                      maturity, tGrid_, dampingSteps_ };
 
+        // a cached solver must not be recalculated when the spot
+        // changes; the other market changes are tracked above
         ext::shared_ptr<FdmBlackScholesSolver> solver(
             ext::make_shared<FdmBlackScholesSolver>(
-                               Handle<GeneralizedBlackScholesProcess>(process_),
-                               payoff->strike(), solverDesc, schemeDesc_,
-                               localVol_, illegalLocalVolOverwrite_));
+                    Handle<GeneralizedBlackScholesProcess>(process_, !caching),
+                    payoff->strike(), solverDesc, schemeDesc_,
+                    localVol_, illegalLocalVolOverwrite_));
 
-        const Real spot = process_->x0();
         results_.value = solver->valueAt(spot);
         results_.delta = solver->deltaAt(spot);
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
 
+        if (caching) {
+            cachedSolver_ = solver;
+            cachedSpot_ = spot;
+            cachedArguments_ = arguments_;
+            marketChanged_ = false;
+        }
+
         // 6. Calculate vanilla option and rebate for in-barriers
         if (   arguments_.barrierType == Barrier::DownIn
             || arguments_.barrierType == Barrier::UpIn) {
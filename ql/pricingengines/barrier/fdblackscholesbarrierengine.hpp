@@ -32,6 +32,8 @@
 
 namespace QuantLib {
 
+    class FdmBlackScholesSolver;
+
     //! Finite-Differences Black Scholes barrier option engine
 
     /*!
@@ -53,12 +55,41 @@ namespace QuantLib {
 
         void calculate() const;
 
+        /*! Keeps the solution of the last calculation of a knock-out
+            option on the whole mesh and interpolates it for later
+            spot values, as long as the option and the market apart
+            from the spot are not modified and the spot does not move
+            further than the given tolerance in log terms; see
+            FdBlackScholesVanillaEngine::enableSpotShiftCaching().
+
+            \warning knock-in options, which are priced by parity
+                     with separate vanilla and rebate options, and
+                     local volatility are not cached.
+        */
+        void enableSpotShiftCaching(Real tolerance = 0.05);
+        void disableSpotShiftCaching();
+
       private:
+        class MarketObserver : public Observer {
+          public:
+            explicit MarketObserver(bool* changed) : changed_(changed) {}
+            void update() { *changed_ = true; }
+          private:
+            bool* changed_;
+        };
+
         const ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         const Size tGrid_, xGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+
+        Real spotTolerance_;
+        ext::shared_ptr<MarketObserver> marketObserver_;
+        mutable bool marketChanged_;
+        mutable ext::shared_ptr<FdmBlackScholesSolver> cachedSolver_;
+        mutable Real cachedSpot_;
+        mutable DividendBarrierOption::arguments cachedArguments_;
     };
 
 
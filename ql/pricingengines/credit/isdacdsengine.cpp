@@ -31,6 +31,55 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // contribution of an interval to the protection leg
+        Real protectionIntegral(Real P0, Real P1, Real Q0, Real Q1, Real fhat,
+                                bool taylor, Real nFix) {
+            Real hhat = std::log(Q0) - std::log(Q1);
+            Real fhphh = fhat + hhat;
+
+            if (fhphh < 1E-4 && taylor) {
+                Real fhphhq = fhphh * fhphh;
+                return
+                    P0 * Q0 * hhat * (1.0 - 0.5 * fhphh + 1.0 / 6.0 * fhphhq -
+                                      1.0 / 24.0 * fhphhq * fhphh +
+                                      1.0 / 120 * fhphhq * fhphhq);
+            } else {
+                return hhat / (fhphh + nFix) * (P0 * Q0 - P1 * Q1);
+            }
+        }
+
+        // contribution of an interval to the default accrual of a coupon
+        Real accrualIntegral(Time t0, Time t1, Time tstart,
+                             Real P0, Real P1, Real Q0, Real Q1, Real fhat,
+                             bool taylor, Real nFix) {
+            Real hhat = std::log(Q0) - std::log(Q1);
+            Real fhphh = fhat + hhat;
+            if (fhphh < 1E-4 && taylor) {
+                // see above, terms up to (f+h)^3 seem more than enough,
+                // what exactly is implemented in the standard isda C
+                // code ?
+                Real fhphhq = fhphh * fhphh;
+                return
+                    hhat * P0 * Q0 *
+                    ((t0 - tstart) *
+                         (1.0 - 0.5 * fhphh + 1.0 / 6.0 * fhphhq -
+                          1.0 / 24.0 * fhphhq * fhphh) +
+                     (t1 - t0) *
+                         (0.5 - 1.0 / 3.0 * fhphh + 1.0 / 8.0 * fhphhq -
+                          1.0 / 30.0 * fhphhq * fhphh));
+            } else {
+                return
+                    (hhat / (fhphh + nFix)) *
+                    ((t1 - t0) * ((P0 * Q0 - P1 * Q1) / (fhphh + nFix) -
+                                  P1 * Q1) +
+                     (t0 - tstart) * (P0 * Q0 - P1 * Q1));
+            }
+        }
+
+    }
+
     IsdaCdsEngine::IsdaCdsEngine(
         const Handle<DefaultProbabilityTermStructure> &probability,
         Real recoveryRate, const Handle<YieldTermStructure> &discountCurve,
@@ -45,6 +94,115 @@ namespace QuantLib {
 
         registerWith(probability_);
         registerWith(discountCurve_);
+
+        discountCurveObserver_ =
+            ext::make_shared<DiscountCurveObserver>(&schedule_);
+        discountCurveObserver_->registerWith(discountCurve_);
+    }
+
+    void IsdaCdsEngine::updateSchedule(const std::vector<Date>& nodes,
+                                       const Date& protectionStart) const {
+
+        Actual365Fixed dc;
+        Actual360 dc1;
+        Actual360 dc2(true);
+
+        Schedule s;
+        s.evaluationDate = Settings::instance().evaluationDate();
+        s.protectionStart = protectionStart;
+        s.maturity = arguments_.maturity;
+        s.nodes = nodes;
+        s.leg = arguments_.leg;
+
+        // nodes of the protection leg
+
+        Date d0 = protectionStart-1;
+        s.protectionDates.push_back(d0);
+        std::vector<Date>::const_iterator it =
+            std::upper_bound(nodes.begin(), nodes.end(), protectionStart);
+        for(;it != nodes.end(); ++it) {
+            if(*it > s.maturity) {
+                s.protectionDates.push_back(s.maturity);
+                break;
+            }
+            s.protectionDates.push_back(*it);
+        }
+
+        std::vector<Real> logP(s.protectionDates.size());
+        std::vector<DiscountFactor> P(s.protectionDates.size());
+        for (Size i = 0; i < s.protectionDates.size(); ++i) {
+            P[i] = discountCurve_->discount(s.protectionDates[i]);
+            logP[i] = std::log(P[i]);
+        }
+        for (Size i = 1; i < s.protectionDates.size(); ++i) {
+            Interval interval = {
+                Null<Time>(), Null<Time>(), P[i-1], P[i],
+                logP[i-1] - logP[i],
+                Null<Probability>(), Null<Probability>(), 0.0
+            };
+            s.protectionIntervals.push_back(interval);
+        }
+
+        // nodes of the default accruals
+
+        Size n = s.leg.size();
+        s.paymentDiscounts.resize(n);
+        s.accrualStartTimes.resize(n);
+        s.accrualDates.resize(n);
+        s.accrualIntervals.resize(n);
+        for (Size i = 0; i < n; ++i) {
+            ext::shared_ptr<FixedRateCoupon> coupon =
+                ext::dynamic_pointer_cast<FixedRateCoupon>(s.leg[i]);
+
+            QL_REQUIRE(coupon->dayCounter() == dc ||
+                           coupon->dayCounter() == dc1 ||
+                           coupon->dayCounter() == dc2,
+                       "ISDA engine requires a coupon day counter Act/365Fixed "
+                           << "or Act/360 (" << coupon->dayCounter() << ")");
+
+            s.paymentDiscounts[i] = discountCurve_->discount(coupon->date());
+
+            if (!detail::simple_event(coupon->accrualEndDate())
+                     .hasOccurred(protectionStart, false)) {
+                Date start = std::max<Date>(coupon->accrualStartDate(),
+                                            protectionStart)-1;
+                Date end = coupon->date()-1;
+                s.accrualStartTimes[i] =
+                    discountCurve_->timeFromReference(coupon->accrualStartDate()-1) -
+                    (accrualBias_ == HalfDayBias ? 1.0 / 730.0 : 0.0);
+                std::vector<Date>& localNodes = s.accrualDates[i];
+                localNodes.push_back(start);
+                //add intermediary nodes, if any
+                if (forwardsInCouponPeriod_ == Piecewise) {
+                    std::vector<Date>::const_iterator it0 =
+                        std::upper_bound(nodes.begin(), nodes.end(), start);
+                    std::vector<Date>::const_iterator it1 =
+                        std::lower_bound(nodes.begin(), nodes.end(), end);
+                    localNodes.insert(localNodes.end(), it0, it1);
+                }
+                localNodes.push_back(end);
+
+                Time t0 = discountCurve_->timeFromReference(localNodes[0]);
+                DiscountFactor P0 = discountCurve_->discount(localNodes[0]);
+                Real logP0 = std::log(P0);
+                for (Size j = 1; j < localNodes.size(); ++j) {
+                    Time t1 = discountCurve_->timeFromReference(localNodes[j]);
+                    DiscountFactor P1 = discountCurve_->discount(localNodes[j]);
+                    Real logP1 = std::log(P1);
+                    Interval interval = {
+                        t0, t1, P0, P1, logP0 - logP1,
+                        Null<Probability>(), Null<Probability>(), 0.0
+                    };
+                    s.accrualIntervals[i].push_back(interval);
+                    t0 = t1;
+                    P0 = P1;
+                    logP0 = logP1;
+                }
+            }
+        }
+
+        s.valid = true;
+        std::swap(schedule_, s);
     }
 
     void IsdaCdsEngine::calculate() const {
@@ -147,43 +305,33 @@ namespace QuantLib {
         if(nodes.empty()){
             nodes.push_back(maturity);
         }
+
+        if (!schedule_.valid || schedule_.evaluationDate != evalDate ||
+            schedule_.protectionStart != effectiveProtectionStart ||
+            schedule_.maturity != maturity || schedule_.nodes != nodes ||
+            schedule_.leg != arguments_.leg)
+            updateSchedule(nodes, effectiveProtectionStart);
+
         const Real nFix = (numericalFix_ == None ? 1E-50 : 0.0);
+        const bool taylor = (numericalFix_ == Taylor);
 
         // protection leg pricing (npv is always negative at this stage)
         Real protectionNpv = 0.0;
 
-        Date d0 = effectiveProtectionStart-1;
-        Real P0 = discountCurve_->discount(d0);
-        Real Q0 = probability_->survivalProbability(d0);
-        Date d1;
-        std::vector<Date>::const_iterator it =
-            std::upper_bound(nodes.begin(), nodes.end(), effectiveProtectionStart);
-
-        for(;it != nodes.end(); ++it) {
-            if(*it > maturity) {
-                d1 = maturity;
-                it = nodes.end() - 1; //early exit
-            } else {
-                d1 = *it;
+        Real Q0 = probability_->survivalProbability(
+                                             schedule_.protectionDates[0]);
+        for (Size i = 0; i < schedule_.protectionIntervals.size(); ++i) {
+            Interval& interval = schedule_.protectionIntervals[i];
+            Real Q1 = probability_->survivalProbability(
+                                           schedule_.protectionDates[i+1]);
+            if (Q0 != interval.Q0 || Q1 != interval.Q1) {
+                interval.value = protectionIntegral(interval.P0, interval.P1,
+                                                    Q0, Q1, interval.fhat,
+                                                    taylor, nFix);
+                interval.Q0 = Q0;
+                interval.Q1 = Q1;
             }
-            Real P1 = discountCurve_->discount(d1);
-            Real Q1 = probability_->survivalProbability(d1);
-
-            Real fhat = std::log(P0) - std::log(P1);
-            Real hhat = std::log(Q0) - std::log(Q1);
-            Real fhphh = fhat + hhat;
-
-            if (fhphh < 1E-4 && numericalFix_ == Taylor) {
-                Real fhphhq = fhphh * fhphh;
-                protectionNpv +=
-                    P0 * Q0 * hhat * (1.0 - 0.5 * fhphh + 1.0 / 6.0 * fhphhq -
-                                      1.0 / 24.0 * fhphhq * fhphh +
-                                      1.0 / 120 * fhphhq * fhphhq);
-            } else {
-                protectionNpv += hhat / (fhphh + nFix) * (P0 * Q0 - P1 * Q1);
-            }
-            d0 = d1;
-            P0 = P1;
+            protectionNpv += interval.value;
             Q0 = Q1;
         }
         protectionNpv *= arguments_.claim->amount(
@@ -196,81 +344,40 @@ namespace QuantLib {
         Real premiumNpv = 0.0, defaultAccrualNpv = 0.0;
         for (Size i = 0; i < arguments_.leg.size(); ++i) {
             ext::shared_ptr<FixedRateCoupon> coupon =
-                ext::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
-
-            QL_REQUIRE(coupon->dayCounter() == dc ||
-                           coupon->dayCounter() == dc1 ||
-                           coupon->dayCounter() == dc2,
-                       "ISDA engine requires a coupon day counter Act/365Fixed "
-                           << "or Act/360 (" << coupon->dayCounter() << ")");
+                ext::static_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
 
             // premium coupons
             if (!arguments_.leg[i]->hasOccurred(effectiveProtectionStart,
                                                 includeSettlementDateFlows_)) {
                 premiumNpv +=
                     coupon->amount() *
-                    discountCurve_->discount(coupon->date()) *
+                    schedule_.paymentDiscounts[i] *
                     probability_->survivalProbability(coupon->date()-1);
             }
 
             // default accruals
 
-            if (!detail::simple_event(coupon->accrualEndDate())
-                     .hasOccurred(effectiveProtectionStart, false)) {
-                Date start = std::max<Date>(coupon->accrualStartDate(),
-                                            effectiveProtectionStart)-1;
-                Date end = coupon->date()-1;
-                Real tstart =
-                    discountCurve_->timeFromReference(coupon->accrualStartDate()-1) -
-                    (accrualBias_ == HalfDayBias ? 1.0 / 730.0 : 0.0);
-                std::vector<Date> localNodes;
-                localNodes.push_back(start);
-                //add intermediary nodes, if any
-                if (forwardsInCouponPeriod_ == Piecewise) {
-                    std::vector<Date>::const_iterator it0 =
-                        std::upper_bound(nodes.begin(), nodes.end(), start);
-                    std::vector<Date>::const_iterator it1 =
-                        std::lower_bound(nodes.begin(), nodes.end(), end);
-                    localNodes.insert(localNodes.end(), it0, it1);
-                }
-                localNodes.push_back(end);
+            std::vector<Interval>& intervals = schedule_.accrualIntervals[i];
+            if (!schedule_.accrualDates[i].empty()) {
+                const std::vector<Date>& localNodes =
+                    schedule_.accrualDates[i];
+                const Time tstart = schedule_.accrualStartTimes[i];
 
                 Real defaultAccrThisNode = 0.;
-                std::vector<Date>::const_iterator node = localNodes.begin();
-                Real t0 = discountCurve_->timeFromReference(*node);
-                Real P0 = discountCurve_->discount(*node);
-                Real Q0 = probability_->survivalProbability(*node);
-
-                for (++node; node != localNodes.end(); ++node) {
-                    Real t1 = discountCurve_->timeFromReference(*node);
-                    Real P1 = discountCurve_->discount(*node);
-                    Real Q1 = probability_->survivalProbability(*node);
-                    Real fhat = std::log(P0) - std::log(P1);
-                    Real hhat = std::log(Q0) - std::log(Q1);
-                    Real fhphh = fhat + hhat;
-                    if (fhphh < 1E-4 && numericalFix_ == Taylor) {
-                        // see above, terms up to (f+h)^3 seem more than enough,
-                        // what exactly is implemented in the standard isda C
-                        // code ?
-                        Real fhphhq = fhphh * fhphh;
-                        defaultAccrThisNode +=
-                            hhat * P0 * Q0 *
-                            ((t0 - tstart) *
-                                 (1.0 - 0.5 * fhphh + 1.0 / 6.0 * fhphhq -
-                                  1.0 / 24.0 * fhphhq * fhphh) +
-                             (t1 - t0) *
-                                 (0.5 - 1.0 / 3.0 * fhphh + 1.0 / 8.0 * fhphhq -
-                                  1.0 / 30.0 * fhphhq * fhphh));
-                    } else {
-                        defaultAccrThisNode +=
-                            (hhat / (fhphh + nFix)) *
-                            ((t1 - t0) * ((P0 * Q0 - P1 * Q1) / (fhphh + nFix) -
-                                          P1 * Q1) +
-                             (t0 - tstart) * (P0 * Q0 - P1 * Q1));
+                Real Q0 = probability_->survivalProbability(localNodes[0]);
+                for (Size j = 0; j < intervals.size(); ++j) {
+                    Interval& interval = intervals[j];
+                    Real Q1 =
+                        probability_->survivalProbability(localNodes[j+1]);
+                    if (Q0 != interval.Q0 || Q1 != interval.Q1) {
+                        interval.value = accrualIntegral(
+                            interval.t0, interval.t1, tstart,
+                            interval.P0, interval.P1, Q0, Q1, interval.fhat,
+                            taylor, nFix);
+                        interval.Q0 = Q0;
+                        interval.Q1 = Q1;
                     }
-
-                    t0 = t1;
-                    P0 = P1;
+                    defaultAccrThisNode += interval.value;
                     Q0 = Q1;
                 }
                 defaultAccrualNpv += defaultAccrThisNode * arguments_.notional *
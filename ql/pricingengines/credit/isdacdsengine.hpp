@@ -113,6 +113,50 @@ namespace QuantLib {
         void calculate() const;
 
       private:
+        /* The integration schedule (the nodes of both legs together with
+           their times and discount factors) only depends on the
+           instrument, on the pillars of the curves and on the discount
+           curve.  It is cached across calls, so that the repeated
+           pricings of a bootstrap, in which only the default curve
+           changes, only evaluate survival probabilities; the
+           contributions of intervals whose survival probabilities did
+           not change are reused as well. */
+        struct Interval {
+            Time t0, t1;
+            DiscountFactor P0, P1;
+            Real fhat;
+            // survival probabilities and contribution of the last call
+            Probability Q0, Q1;
+            Real value;
+        };
+        struct Schedule {
+            Schedule() : valid(false) {}
+            bool valid;
+            // inputs
+            Date evaluationDate, protectionStart, maturity;
+            std::vector<Date> nodes;
+            Leg leg;
+            // protection leg, dates[i] is the start of intervals[i]
+            std::vector<Date> protectionDates;
+            std::vector<Interval> protectionIntervals;
+            // premium leg, by coupon
+            std::vector<DiscountFactor> paymentDiscounts;
+            std::vector<Time> accrualStartTimes;
+            std::vector<std::vector<Date> > accrualDates;
+            std::vector<std::vector<Interval> > accrualIntervals;
+        };
+        class DiscountCurveObserver : public Observer {
+          public:
+            explicit DiscountCurveObserver(Schedule* schedule)
+            : schedule_(schedule) {}
+            void update() { schedule_->valid = false; }
+          private:
+            Schedule* schedule_;
+        };
+
+        void updateSchedule(const std::vector<Date>& nodes,
+                            const Date& protectionStart) const;
+
         Handle<DefaultProbabilityTermStructure> probability_;
         const Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
@@ -120,6 +164,8 @@ namespace QuantLib {
         const NumericalFix numericalFix_;
         const AccrualBias accrualBias_;
         const ForwardsInCouponPeriod forwardsInCouponPeriod_;
+        mutable Schedule schedule_;
+        ext::shared_ptr<DiscountCurveObserver> discountCurveObserver_;
     };
 }
 
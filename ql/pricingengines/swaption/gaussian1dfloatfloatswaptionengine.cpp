@@ -230,6 +230,42 @@ namespace QuantLib {
             event0Time = std::max(
                 model_->termStructure()->timeFromReference(event0), 0.0);
 
+            // discount factors of the coupons fixing at the event date
+            // and numeraire on the state grid, taken from the model cache
+            const bool onGrid = isEventDate && event0 > expiry;
+            Size leg1Start = std::find(arguments_.leg1FixingDates.begin(),
+                                       arguments_.leg1FixingDates.end(),
+                                       event0) -
+                             arguments_.leg1FixingDates.begin();
+            Size leg2Start = std::find(arguments_.leg2FixingDates.begin(),
+                                       arguments_.leg2FixingDates.end(),
+                                       event0) -
+                             arguments_.leg2FixingDates.begin();
+            std::vector<Array> leg1Zerobonds, leg2Zerobonds;
+            Array numeraires;
+            if (onGrid) {
+                for (Size j = leg1Start;
+                     j < arguments_.leg1FixingDates.size() &&
+                     arguments_.leg1FixingDates[j] == event0;
+                     j++)
+                    leg1Zerobonds.push_back(model_->zerobondGrid(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.leg1PayDates[j]),
+                        event0Time, stddevs_, integrationPoints_,
+                        discountCurve_));
+                for (Size j = leg2Start;
+                     j < arguments_.leg2FixingDates.size() &&
+                     arguments_.leg2FixingDates[j] == event0;
+                     j++)
+                    leg2Zerobonds.push_back(model_->zerobondGrid(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.leg2PayDates[j]),
+                        event0Time, stddevs_, integrationPoints_,
+                        discountCurve_));
+                numeraires = model_->numeraireGrid(
+                    event0Time, stddevs_, integrationPoints_, discountCurve_);
+            }
+
             // todo add openmp support later on (as in gaussian1dswaptionengine)
 
             for (Size k = 0; k < (event0 > expiry ? npv0.size() : 1); k++) {
@@ -442,15 +478,16 @@ namespace QuantLib {
                 if (isEventDate) {
 
                     Real zk = event0 > expiry ? z[k] : y;
+                    Real numeraire =
+                        onGrid ? numeraires[k]
+                               : model_->numeraire(event0Time, zk,
+                                                   discountCurve_);
 
                     if (isLeg1Fixing) { // if event is a fixing date and
                                         // exercise date,
                         // the coupon is part of the exercise into right (by
                         // definition)
-                        Size j = std::find(arguments_.leg1FixingDates.begin(),
-                                           arguments_.leg1FixingDates.end(),
-                                           event0) -
-                                 arguments_.leg1FixingDates.begin();
+                        Size j = leg1Start;
                         Real zSpreadDf =
                             oas_.empty()
                                 ? 1.0
@@ -509,13 +546,13 @@ namespace QuantLib {
                                          arguments_.leg1AccrualTimes[j];
                             }
 
+                            Real zerobond =
+                                onGrid ? leg1Zerobonds[j - leg1Start][k]
+                                       : model_->zerobond(
+                                             arguments_.leg1PayDates[j],
+                                             event0, zk, discountCurve_);
                             npv0a[k] -=
-                                amount *
-                                model_->zerobond(arguments_.leg1PayDates[j],
-                                                 event0, zk, discountCurve_) /
-                                model_->numeraire(event0Time, zk,
-                                                  discountCurve_) *
-                                zSpreadDf;
+                                amount * zerobond / numeraire * zSpreadDf;
 
                             if (j < arguments_.leg1FixingDates.size() - 1) {
                                 j++;
@@ -531,10 +568,7 @@ namespace QuantLib {
                                         // exercise date,
                         // the coupon is part of the exercise into right (by
                         // definition)
-                        Size j = std::find(arguments_.leg2FixingDates.begin(),
-                                           arguments_.leg2FixingDates.end(),
-                                           event0) -
-                                 arguments_.leg2FixingDates.begin();
+                        Size j = leg2Start;
                         Real zSpreadDf =
                             oas_.empty()
                                 ? 1.0
@@ -587,13 +621,13 @@ namespace QuantLib {
                                          arguments_.leg2AccrualTimes[j];
                             }
 
+                            Real zerobond =
+                                onGrid ? leg2Zerobonds[j - leg2Start][k]
+                                       : model_->zerobond(
+                                             arguments_.leg2PayDates[j],
+                                             event0, zk, discountCurve_);
                             npv0a[k] +=
-                                amount *
-                                model_->zerobond(arguments_.leg2PayDates[j],
-                                                 event0, zk, discountCurve_) /
-                                model_->numeraire(event0Time, zk,
-                                                  discountCurve_) *
-                                zSpreadDf;
+                                amount * zerobond / numeraire * zSpreadDf;
                             if (j < arguments_.leg2FixingDates.size() - 1) {
                                 j++;
                                 done =
@@ -627,8 +661,7 @@ namespace QuantLib {
                         Real exerciseValue =
                             (type == Option::Call ? 1.0 : -1.0) * npv0a[k] +
                             rebate * model_->zerobond(rebateDate, event0) *
-                                zSpreadDf / model_->numeraire(event0Time, zk,
-                                                              discountCurve_);
+                                zSpreadDf / numeraire;
 
                         if (considerProbabilities && probabilities_ != None) {
                             if (exIdx == noEx) {
@@ -199,6 +199,33 @@ namespace QuantLib {
                                  arguments_.floatingResetDates.end(), expiry0 - 1) -
                 arguments_.floatingResetDates.begin();
 
+            // discount factors and numeraire on the state grid, taken
+            // from the model cache
+            std::vector<Array> floatingZerobonds, fixedZerobonds;
+            Array rebateZerobonds, numeraires;
+            if (expiry0 > settlement) {
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++)
+                    floatingZerobonds.push_back(model_->zerobondGrid(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.floatingPayDates[l]),
+                        expiry0Time, stddevs_, integrationPoints_,
+                        discountCurve_));
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++)
+                    fixedZerobonds.push_back(model_->zerobondGrid(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.fixedPayDates[l]),
+                        expiry0Time, stddevs_, integrationPoints_,
+                        discountCurve_));
+                rebateZerobonds = model_->zerobondGrid(
+                    model_->termStructure()->timeFromReference(
+                        rebatedExercise != NULL
+                            ? rebatedExercise->rebatePaymentDate(idx)
+                            : expiry0),
+                    expiry0Time, stddevs_, integrationPoints_, discountCurve_);
+                numeraires = model_->numeraireGrid(
+                    expiry0Time, stddevs_, integrationPoints_, discountCurve_);
+            }
+
             // todo add openmp support later on (as in gaussian1dswaptionengine)
 
             for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
@@ -388,10 +415,7 @@ namespace QuantLib {
                                               arguments_.swap->iborIndex()) +
                                       arguments_.floatingSpreads[l]);
                         floatingLegNpv +=
-                            amount *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                            amount * floatingZerobonds[l - k1][k] * zSpreadDf;
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
@@ -405,11 +429,8 @@ namespace QuantLib {
                                            .yearFraction(
                                                 expiry0,
                                                 arguments_.fixedPayDates[l])));
-                        fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                        fixedLegNpv += arguments_.fixedCoupons[l] *
+                                       fixedZerobonds[l - j1][k] * zSpreadDf;
                     }
                     Real rebate = 0.0;
                     Real zSpreadDf = 1.0;
@@ -429,10 +450,8 @@ namespace QuantLib {
                     Real exerciseValue =
                         ((type == Option::Call ? 1.0 : -1.0) *
                              (floatingLegNpv - fixedLegNpv) +
-                         rebate * model_->zerobond(rebateDate, expiry0, z[k],
-                                                   discountCurve_) *
-                             zSpreadDf) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                         rebate * rebateZerobonds[k] * zSpreadDf) /
+                        numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -447,8 +466,7 @@ namespace QuantLib {
                                     : 1.0 / (model_->zerobond(expiry0Time, 0.0,
                                                               0.0,
                                                               discountCurve_) *
-                                             model_->numeraire(expiry0, z[k],
-                                                               discountCurve_));
+                                             numeraires[k]);
                         if (exerciseValue >= npv0[k]) {
                             npvp0[idx - minIdxAlive][k] =
                                 probabilities_ == Naive
@@ -457,8 +475,7 @@ namespace QuantLib {
                                           (model_->zerobond(expiry0Time, 0.0,
                                                             0.0,
                                                             discountCurve_) *
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
+                                           numeraires[k]);
                             for (Size ii = idx - minIdxAlive + 1;
                                  ii < npvp0.size(); ii++)
                                 npvp0[ii][k] = 0.0;
@@ -104,17 +104,32 @@ namespace QuantLib {
                     model_->forwardRate(arguments_.floatingFixingDates[l],
                                         expiry0, 0.0,
                                         arguments_.swap->iborIndex());
-                    model_->zerobond(arguments_.floatingPayDates[l], expiry0,
-                                     0.0, discountCurve_);
                 }
-                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                    model_->zerobond(arguments_.fixedPayDates[l], expiry0, 0.0,
-                                     discountCurve_);
-                }
-                model_->numeraire(expiry0Time, 0.0, discountCurve_);
             }
 #endif
 
+            // discount factors and numeraire on the state grid, taken
+            // from the model cache; for the same reasons as above, this
+            // has to be done outside of the parallelized loop
+            std::vector<Array> floatingZerobonds, fixedZerobonds;
+            Array numeraires;
+            if (expiry0 > settlement) {
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++)
+                    floatingZerobonds.push_back(model_->zerobondGrid(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.floatingPayDates[l]),
+                        expiry0Time, stddevs_, integrationPoints_,
+                        discountCurve_));
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++)
+                    fixedZerobonds.push_back(model_->zerobondGrid(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.fixedPayDates[l]),
+                        expiry0Time, stddevs_, integrationPoints_,
+                        discountCurve_));
+                numeraires = model_->numeraireGrid(
+                    expiry0Time, stddevs_, integrationPoints_, discountCurve_);
+            }
+
 #pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
             for (long k = 0; k < (expiry0 > settlement ? (long)npv0.size() : 1);
                  k++) {
@@ -264,20 +279,16 @@ namespace QuantLib {
                              model_->forwardRate(
                                  arguments_.floatingFixingDates[l], expiry0,
                                  z[k], arguments_.swap->iborIndex())) *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                            floatingZerobonds[l - k1][k];
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                        fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                        fixedLegNpv += arguments_.fixedCoupons[l] *
+                                       fixedZerobonds[l - j1][k];
                     }
                     Real exerciseValue =
                         (type == Option::Call ? 1.0 : -1.0) *
-                        (floatingLegNpv - fixedLegNpv) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                        (floatingLegNpv - fixedLegNpv) / numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -292,8 +303,7 @@ namespace QuantLib {
                                     : 1.0 / (model_->zerobond(expiry0Time, 0.0,
                                                               0.0,
                                                               discountCurve_) *
-                                             model_->numeraire(expiry0, z[k],
-                                                               discountCurve_));
+                                             numeraires[k]);
                         if (exerciseValue >= npv0[k]) {
                             npvp0[idx - minIdxAlive][k] =
                                 probabilities_ == Naive
@@ -302,8 +312,7 @@ namespace QuantLib {
                                           (model_->zerobond(expiry0Time, 0.0,
                                                             0.0,
                                                             discountCurve_) *
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
+                                           numeraires[k]);
                             for (Size ii = idx - minIdxAlive + 1;
                                  ii < npvp0.size(); ii++)
                                 npvp0[ii][k] = 0.0;
@@ -40,6 +40,7 @@
 #include <ql/pricingengines/vanilla/fdstepconditionengine.hpp>
 #include <ql/pricingengines/vanilla/fdvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdconditions.hpp>
+#include <ql/pricingengines/vanilla/fftslicepricer.hpp>
 #include <ql/pricingengines/vanilla/mcamericanengine.hpp>
 #include <ql/pricingengines/vanilla/mcdigitalengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
@@ -33,6 +33,7 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <algorithm>
 
 
 #if defined(QL_PATCH_MSVC)
@@ -150,6 +151,10 @@ namespace QuantLib {
 
         Real operator()(Real phi) const;
 
+        // strike-independent part of the exponent of the integrand
+        // in Gatheral's formulation, phi must not be zero
+        std::complex<Real> gatheralExponent(Real phi) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -248,8 +253,8 @@ namespace QuantLib {
     }
 
 
-    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
-    {
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::gatheralExponent(Real phi) const {
         const Real rpsig(rsigma_*phi);
 
         const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
@@ -260,33 +265,34 @@ namespace QuantLib {
         const std::complex<Real> addOnTerm
             = engine_ ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
+        if (sigma_ > 1e-5) {
+            const std::complex<Real> p = (t1-d)/(t1+d);
+            const std::complex<Real> g
+                                    = std::log((1.0 - p*ex)/(1.0 - p));
+
+            return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                + addOnTerm;
+        }
+        else {
+            const std::complex<Real> td = phi/(2.0*t1)
+                           *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+            const std::complex<Real> p = td*sigma2_/(t1+d);
+            const std::complex<Real> g = p*(1.0-ex);
+
+            return v0_*td*(1.0-ex)/(1.0-p*ex)
+                + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                + addOnTerm;
+        }
+    }
+
+    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
         if (cpxLog_ == Gatheral) {
             if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+                return std::exp(gatheralExponent(phi)
+                                + std::complex<Real>(0.0, phi*(dd_-sx_))
+                                ).imag()/phi;
             }
             else {
                 // use l'Hospital's rule to get lim_{phi->0}
@@ -312,6 +318,16 @@ namespace QuantLib {
             }
         }
         else if (cpxLog_ == BranchCorrection) {
+            const Real rpsig(rsigma_*phi);
+
+            const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
+            const std::complex<Real> d =
+                std::sqrt(t1*t1 - sigma2_*phi
+                          *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
+            const std::complex<Real> ex = std::exp(-d*term_);
+            const std::complex<Real> addOnTerm
+                = engine_ ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+
             const std::complex<Real> p = (t1+d)/(t1-d);
 
             // next term: g = std::log((1.0 - p*std::exp(d*term_))/(1.0 - p))
@@ -575,6 +591,13 @@ namespace QuantLib {
         }
     }
 
+    void AnalyticHestonEngine::update() {
+        nodeCache_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
     void AnalyticHestonEngine::calculate() const
     {
         // this is a european option pricer
@@ -586,35 +609,213 @@ namespace QuantLib {
             ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non plain vanilla payoff given");
 
+        results_.value = optionPrice(payoff->optionType(), payoff->strike(),
+                                     arguments_.exercise->lastDate());
+    }
+
+    Disposable<Array> AnalyticHestonEngine::prices(
+                                    Option::Type type,
+                                    const std::vector<Real>& strikes,
+                                    const Date& maturity) const {
+        // going through calculate() keeps derived engines, which
+        // set up maturity-dependent data there, consistent.
+        arguments_.exercise = ext::make_shared<EuropeanExercise>(maturity);
+
+        Array result(strikes.size());
+        Size evaluations = 0;
+        for (Size i=0; i < strikes.size(); ++i) {
+            arguments_.payoff =
+                ext::make_shared<PlainVanillaPayoff>(type, strikes[i]);
+            results_.reset();
+            calculate();
+            result[i] = results_.value;
+            evaluations += evaluations_;
+        }
+        evaluations_ = evaluations;
+
+        return result;
+    }
+
+    Real AnalyticHestonEngine::optionPrice(Option::Type type,
+                                           Real strikePrice,
+                                           const Date& maturity) const {
         const ext::shared_ptr<HestonProcess>& process = model_->process();
 
-        const Real riskFreeDiscount = process->riskFreeRate()->discount(
-                                            arguments_.exercise->lastDate());
-        const Real dividendDiscount = process->dividendYield()->discount(
-                                            arguments_.exercise->lastDate());
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
 
         const Real spotPrice = process->s0()->value();
         QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
 
-        const Real strikePrice = payoff->strike();
-        const Real term = process->time(arguments_.exercise->lastDate());
+        const Real term = process->time(maturity);
+
+        if (!useNodeCache()) {
+            Real value;
+            doCalculation(riskFreeDiscount,
+                          dividendDiscount,
+                          spotPrice,
+                          strikePrice,
+                          term,
+                          model_->kappa(),
+                          model_->theta(),
+                          model_->sigma(),
+                          model_->v0(),
+                          model_->rho(),
+                          PlainVanillaPayoff(type, strikePrice),
+                          *integration_,
+                          cpxLog_,
+                          this,
+                          value,
+                          evaluations_);
+            return value;
+        }
+
+        const NodeValues& nodes = nodeValues(term);
+        const Size n = nodes.x.size();
+
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+        const Real z = std::log(spotPrice/(ratio*strikePrice));
+
+        switch (cpxLog_) {
+          case Gatheral: {
+            Real p1 = 0.0, p2 = 0.0;
+            for (Size k=0; k < n; ++k) {
+                const Real s = std::sin(nodes.x[k]*z);
+                const Real c = std::cos(nodes.x[k]*z);
+                p1 += nodes.re1[k]*s + nodes.im1[k]*c;
+                p2 += nodes.re2[k]*s + nodes.im2[k]*c;
+            }
+            p1 /= M_PI;
+            p2 /= M_PI;
+            evaluations_ = 2*n;
+
+            switch (type) {
+              case Option::Call:
+                return spotPrice*dividendDiscount*(p1+0.5)
+                    - strikePrice*riskFreeDiscount*(p2+0.5);
+              case Option::Put:
+                return spotPrice*dividendDiscount*(p1-0.5)
+                    - strikePrice*riskFreeDiscount*(p2-0.5);
+              default:
+                QL_FAIL("unknown option type");
+            }
+          }
+          case AndersenPiterbarg: {
+            Real h = 0.0;
+            for (Size k=0; k < n; ++k) {
+                const Real s = std::sin(nodes.x[k]*z);
+                const Real c = std::cos(nodes.x[k]*z);
+                h += nodes.re1[k]*c - nodes.im1[k]*s;
+            }
+            evaluations_ = n;
+
+            const Real fwdPrice = spotPrice / ratio;
+            const Real bsPrice
+                = BlackCalculator(Option::Call, strikePrice,
+                                  fwdPrice, std::sqrt(nodes.vAvg*term),
+                                  riskFreeDiscount).value();
+            const Real h_cv =
+                h*std::sqrt(strikePrice*fwdPrice)*riskFreeDiscount/M_PI;
 
-        doCalculation(riskFreeDiscount,
-                      dividendDiscount,
-                      spotPrice,
-                      strikePrice,
-                      term,
-                      model_->kappa(),
-                      model_->theta(),
-                      model_->sigma(),
-                      model_->v0(),
-                      model_->rho(),
-                      *payoff,
-                      *integration_,
-                      cpxLog_,
-                      this,
-                      results_.value,
-                      evaluations_);
+            switch (type) {
+              case Option::Call:
+                return bsPrice + h_cv;
+              case Option::Put:
+                return bsPrice + h_cv
+                    - riskFreeDiscount*(fwdPrice - strikePrice);
+              default:
+                QL_FAIL("unknown option type");
+            }
+          }
+          default:
+            QL_FAIL("unknown complex log formula");
+        }
+    }
+
+    bool AnalyticHestonEngine::useNodeCache() const {
+        return integration_->isGaussianQuadrature()
+            && (cpxLog_ == Gatheral || cpxLog_ == AndersenPiterbarg);
+    }
+
+    const AnalyticHestonEngine::NodeValues&
+    AnalyticHestonEngine::nodeValues(Time term) const {
+        // the model notifies its observers on parameter changes,
+        // comparing the parameters is a cheap additional safeguard.
+        const Array params = model_->params();
+        if (params.size() != nodeCacheParams_.size()
+            || !std::equal(params.begin(), params.end(),
+                           nodeCacheParams_.begin())) {
+            nodeCache_.clear();
+            nodeCacheParams_ = params;
+        }
+
+        const std::map<Time, NodeValues>::const_iterator iter
+            = nodeCache_.find(term);
+        if (iter != nodeCache_.end())
+            return iter->second;
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        NodeValues nodes;
+        nodes.vAvg = (1-std::exp(-kappa*term))*(v0-theta)/(kappa*term)
+            + theta;
+
+        Array w;
+        if (cpxLog_ == Gatheral) {
+            const Real c_inf = std::min(0.2, std::max(0.0001,
+                std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+            integration_->nodesAndWeights(c_inf, nodes.x, w);
+
+            // spot, strike and ratio only enter the phase of the
+            // integrand, hence dummy values can be used here.
+            const Fj_Helper f1(kappa, theta, sigma, v0, 1.0, rho, this,
+                               cpxLog_, term, 1.0, 1.0, 1);
+            const Fj_Helper f2(kappa, theta, sigma, v0, 1.0, rho, this,
+                               cpxLog_, term, 1.0, 1.0, 2);
+
+            const Size n = nodes.x.size();
+            nodes.re1 = nodes.im1 = nodes.re2 = nodes.im2 = Array(n);
+            for (Size k=0; k < n; ++k) {
+                const Real phi = nodes.x[k];
+                const std::complex<Real> c1
+                    = std::exp(f1.gatheralExponent(phi))*(w[k]/phi);
+                const std::complex<Real> c2
+                    = std::exp(f2.gatheralExponent(phi))*(w[k]/phi);
+                nodes.re1[k] = c1.real(); nodes.im1[k] = c1.imag();
+                nodes.re2[k] = c2.real(); nodes.im2[k] = c2.imag();
+            }
+        }
+        else {
+            const Real c_inf =
+                std::sqrt(1.0-rho*rho)*(v0 + kappa*theta*term)/sigma;
+            integration_->nodesAndWeights(c_inf, nodes.x, w);
+
+            const Real sigmaBS = std::sqrt(nodes.vAvg);
+            const Size n = nodes.x.size();
+            nodes.re1 = nodes.im1 = Array(n);
+            for (Size k=0; k < n; ++k) {
+                const Real u = nodes.x[k];
+                QL_REQUIRE(   addOnTerm(u, term, 1) == std::complex<Real>(0.0)
+                           && addOnTerm(u, term, 2) == std::complex<Real>(0.0),
+                           "only Heston model is supported");
+
+                const std::complex<Real> z(u, -0.5);
+                const std::complex<Real> phiBS
+                    = std::exp(-0.5*sigmaBS*sigmaBS*term
+                               *(z*z + std::complex<Real>(-z.imag(), z.real())));
+                const std::complex<Real> c
+                    = (phiBS - chF(z, term))*(w[k]/(u*u + 0.25));
+                nodes.re1[k] = c.real(); nodes.im1[k] = c.imag();
+            }
+        }
+
+        return nodeCache_[term] = nodes;
     }
 
 
@@ -731,6 +932,43 @@ namespace QuantLib {
             || intAlgo_ == Trapezoid;
     }
 
+    bool AnalyticHestonEngine::Integration::isGaussianQuadrature() const {
+        return bool(gaussianQuadrature_);
+    }
+
+    void AnalyticHestonEngine::Integration::nodesAndWeights(
+                                    Real c_inf, Array& x, Array& w) const {
+        QL_REQUIRE(gaussianQuadrature_, "Gaussian quadrature required");
+
+        const Array& nodes = gaussianQuadrature_->x();
+        const Array& weights = gaussianQuadrature_->weights();
+
+        switch(intAlgo_) {
+          case GaussLaguerre:
+            x = nodes;
+            w = weights;
+            break;
+          case GaussLegendre:
+          case GaussChebyshev:
+          case GaussChebyshev2nd: {
+            // see integrand1, nodes at the upper limit do not contribute
+            std::vector<Real> xt, wt;
+            for (Size i=0; i < nodes.size(); ++i) {
+                const Real u = (1.0-nodes[i])*c_inf;
+                if (u > QL_EPSILON) {
+                    xt.push_back(-std::log(0.5-0.5*nodes[i])/c_inf);
+                    wt.push_back(weights[i]/u);
+                }
+            }
+            x = Array(xt.begin(), xt.end());
+            w = Array(wt.begin(), wt.end());
+          }
+            break;
+          default:
+            QL_FAIL("unknown Gaussian quadrature");
+        }
+    }
+
     Real AnalyticHestonEngine::Integration::calculate(
                                Real c_inf,
                                const ext::function<Real(Real)>& f,
@@ -33,6 +33,7 @@
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/functional.hpp>
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -78,6 +79,19 @@ namespace QuantLib {
         Atlantic Financial Press London.
 
 
+        Performance detail:
+        For the non-adaptive Gaussian quadratures the Fourier
+        integrands can be split into a strike-independent factor,
+        which depends on the model and the maturity only, and a
+        strike-dependent phase. In conjunction with Gatheral's or
+        Andersen-Piterbarg's formula the engine therefore evaluates
+        the characteristic function once per maturity on the
+        quadrature nodes and reuses these values for all further
+        strikes of the same maturity. The cache is reset whenever
+        the model changes. This is used e.g. by calibrations in which
+        all HestonModelHelper instances share the same engine, or by
+        pricing a whole strike grid at once via prices().
+
         \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
@@ -115,9 +129,19 @@ namespace QuantLib {
         std::complex<Real> chF(const std::complex<Real>& z, Time t) const;
         std::complex<Real> lnChF(const std::complex<Real>& z, Time t) const;
 
+        void update();
         void calculate() const;
         Size numberOfEvaluations() const;
 
+        //! prices of European options on a strike grid of one maturity
+        /*! The characteristic function is evaluated only once on
+            the quadrature nodes and reused for all strikes if the
+            integration is a non-adaptive Gaussian quadrature.
+        */
+        Disposable<Array> prices(Option::Type type,
+                                 const std::vector<Real>& strikes,
+                                 const Date& maturity) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -142,10 +166,27 @@ namespace QuantLib {
         class Fj_Helper;
         class AP_Helper;
 
+        // strike-independent part of the Fourier integrands of one
+        // maturity, evaluated on the quadrature nodes and already
+        // multiplied by the quadrature weights
+        struct NodeValues {
+            Array x;
+            Array re1, im1, re2, im2;
+            Real vAvg;
+        };
+
+        bool useNodeCache() const;
+        const NodeValues& nodeValues(Time term) const;
+        Real optionPrice(Option::Type type, Real strikePrice,
+                         const Date& maturity) const;
+
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const ext::shared_ptr<Integration> integration_;
         const Real andersenPiterbargEpsilon_;
+
+        mutable std::map<Time, NodeValues> nodeCache_;
+        mutable Array nodeCacheParams_;
     };
 
 
@@ -183,6 +224,11 @@ namespace QuantLib {
 
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
+        bool isGaussianQuadrature() const;
+
+        // nodes and weights of a Gaussian quadrature, such that
+        // calculate(c_inf, f) is given by sum_i w[i]*f(x[i])
+        void nodesAndWeights(Real c_inf, Array& x, Array& w) const;
 
       private:
         enum Algorithm
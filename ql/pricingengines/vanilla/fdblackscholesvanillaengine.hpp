@@ -41,6 +41,7 @@ namespace QuantLib {
               and comparison with Black pricing.
     */
     class GeneralizedBlackScholesProcess;
+    class FdmBlackScholesSolver;
 
     class FdBlackScholesVanillaEngine : public DividendVanillaOption::engine {
       public:
@@ -54,12 +55,42 @@ namespace QuantLib {
 
         void calculate() const;
 
+        /*! Keeps the solution of the last calculation on the whole
+            mesh.  As long as the option, the rates, the dividend
+            yield, the volatility and the evaluation date are not
+            modified, later calculations for a spot \f$ S \f$ with
+            \f$ |\ln(S/S_0)| \le \f$ <tt>tolerance</tt>, \f$ S_0
+            \f$ being the spot of the last full calculation,
+            interpolate the cached solution instead of solving the
+            PDE again.
+
+            \warning the cache is not used with local volatility,
+                     since the latter might depend on the spot.
+        */
+        void enableSpotShiftCaching(Real tolerance = 0.05);
+        void disableSpotShiftCaching();
+
       private:
+        class MarketObserver : public Observer {
+          public:
+            explicit MarketObserver(bool* changed) : changed_(changed) {}
+            void update() { *changed_ = true; }
+          private:
+            bool* changed_;
+        };
+
         const ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         const Size tGrid_, xGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+
+        Real spotTolerance_;
+        ext::shared_ptr<MarketObserver> marketObserver_;
+        mutable bool marketChanged_;
+        mutable ext::shared_ptr<FdmBlackScholesSolver> cachedSolver_;
+        mutable Real cachedSpot_;
+        mutable DividendVanillaOption::arguments cachedArguments_;
     };
 }
 
@@ -0,0 +1,206 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/fastfouriertransform.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/models/equity/batesmodel.hpp>
+#include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <ql/pricingengines/vanilla/fftslicepricer.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        class HestonCharacteristicFunction {
+          public:
+            HestonCharacteristicFunction(
+                          const ext::shared_ptr<HestonModel>& model, Time t)
+            : engine_(ext::make_shared<AnalyticHestonEngine>(model)),
+              batesModel_(ext::dynamic_pointer_cast<BatesModel>(model)),
+              t_(t) {
+                QL_REQUIRE(
+                    !ext::dynamic_pointer_cast<BatesDetJumpModel>(model)
+                    && !ext::dynamic_pointer_cast<BatesDoubleExpModel>(model),
+                    "Bates models with deterministic jump intensity or "
+                    "double-exponential jumps are not supported");
+            }
+
+            std::complex<Real> operator()(const std::complex<Real>& z) const {
+                std::complex<Real> l = engine_->lnChF(z, t_);
+
+                if (batesModel_) {
+                    const Real nu = batesModel_->nu();
+                    const Real delta2
+                        = 0.5*batesModel_->delta()*batesModel_->delta();
+                    const Real lambda = batesModel_->lambda();
+
+                    // i*z, see BatesEngine::addOnTerm
+                    const std::complex<Real> g(-z.imag(), z.real());
+                    l += t_*lambda*(std::exp(nu*g + delta2*g*g) - 1.0
+                                    - g*(std::exp(nu+delta2) - 1.0));
+                }
+
+                return std::exp(l);
+            }
+
+          private:
+            const ext::shared_ptr<AnalyticHestonEngine> engine_;
+            const ext::shared_ptr<BatesModel> batesModel_;
+            const Time t_;
+        };
+
+        class PTDHestonCharacteristicFunction {
+          public:
+            PTDHestonCharacteristicFunction(
+                const ext::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
+                Time t)
+            : engine_(ext::make_shared<AnalyticPTDHestonEngine>(model)),
+              t_(t) {}
+
+            std::complex<Real> operator()(const std::complex<Real>& z) const {
+                return engine_->chF(z, t_);
+            }
+
+          private:
+            const ext::shared_ptr<AnalyticPTDHestonEngine> engine_;
+            const Time t_;
+        };
+    }
+
+    FFTSlicePricer::FFTSlicePricer(Size order,
+                                   Real logStrikeSpacing, Real alpha)
+    : order_(order), lambda_(logStrikeSpacing), alpha_(alpha) {
+        QL_REQUIRE(order_ > 1, "FFT order must be larger than one");
+        QL_REQUIRE(lambda_ > 0.0, "positive log strike spacing required");
+        QL_REQUIRE(alpha_ > 0.0, "positive damping factor required");
+    }
+
+    Disposable<Array> FFTSlicePricer::normalizedCallPrices(
+                                    const CharacteristicFunction& phi) const {
+        const Size n = Size(1) << order_;
+
+        // strike range and grid spacing (equations 19, 20 and 23)
+        const Real b = n*lambda_/2.0;
+        const Real eta = 2.0*M_PI/(lambda_*n);
+
+        const std::complex<Real> i1(0.0, 1.0);
+
+        std::vector<std::complex<Real> > fti(n);
+        for (Size j=0; j < n; ++j) {
+            const Real v = eta*j;
+            // Simpson weights
+            const Real sw =
+                eta*(3.0 + ((j % 2) == 0 ? -1.0 : 1.0) - (j == 0 ? 1.0 : 0.0))
+                / 3.0;
+
+            const std::complex<Real> psi
+                = phi(v - (alpha_+1.0)*i1)
+                / (alpha_*alpha_ + alpha_ - v*v + i1*(2.0*alpha_+1.0)*v);
+
+            fti[j] = std::exp(i1*b*v)*sw*psi;
+        }
+
+        std::vector<std::complex<Real> > results(n);
+        FastFourierTransform(order_).transform(
+            fti.begin(), fti.end(), results.begin());
+
+        Array prices(n);
+        for (Size j=0; j < n; ++j) {
+            const Real k = -b + lambda_*j;
+            prices[j] = std::exp(-alpha_*k)/M_PI*results[j].real();
+        }
+
+        return prices;
+    }
+
+    Disposable<Array> FFTSlicePricer::prices(
+                                    const CharacteristicFunction& phi,
+                                    Option::Type type,
+                                    Real forward,
+                                    DiscountFactor discount,
+                                    const std::vector<Real>& strikes) const {
+        return prices(phi, std::vector<Option::Type>(strikes.size(), type),
+                      forward, discount, strikes);
+    }
+
+    Disposable<Array> FFTSlicePricer::prices(
+                                    const CharacteristicFunction& phi,
+                                    const std::vector<Option::Type>& types,
+                                    Real forward,
+                                    DiscountFactor discount,
+                                    const std::vector<Real>& strikes) const {
+        QL_REQUIRE(types.size() == strikes.size(),
+                   "number of option types (" << types.size()
+                   << ") and strikes (" << strikes.size() << ") differ");
+        QL_REQUIRE(forward > 0.0, "positive forward required");
+
+        const Array callPrices = normalizedCallPrices(phi);
+
+        const Size n = callPrices.size();
+        const Real b = n*lambda_/2.0;
+        Array k(n);
+        for (Size j=0; j < n; ++j)
+            k[j] = -b + lambda_*j;
+
+        CubicNaturalSpline interpolation(k.begin(), k.end(),
+                                         callPrices.begin());
+
+        Array result(strikes.size());
+        for (Size i=0; i < strikes.size(); ++i) {
+            const Real strike = strikes[i];
+            QL_REQUIRE(strike > 0.0, "positive strike required");
+
+            const Real logMoneyness = std::log(strike/forward);
+            QL_REQUIRE(logMoneyness >= k.front() && logMoneyness <= k.back(),
+                       "strike " << strike << " is outside of the "
+                       "log-strike grid of the FFT");
+
+            const Real callPrice
+                = discount*forward*interpolation(logMoneyness);
+
+            switch (types[i]) {
+              case Option::Call:
+                result[i] = callPrice;
+                break;
+              case Option::Put:
+                result[i] = callPrice - discount*(forward - strike);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+        }
+
+        return result;
+    }
+
+    FFTSlicePricer::CharacteristicFunction
+    FFTSlicePricer::characteristicFunction(
+                                    const ext::shared_ptr<HestonModel>& model,
+                                    Time t) {
+        return HestonCharacteristicFunction(model, t);
+    }
+
+    FFTSlicePricer::CharacteristicFunction
+    FFTSlicePricer::characteristicFunction(
+            const ext::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
+            Time t) {
+        return PTDHestonCharacteristicFunction(model, t);
+    }
+
+}
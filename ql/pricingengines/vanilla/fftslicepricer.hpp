@@ -0,0 +1,113 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fftslicepricer.hpp
+    \brief Carr-Madan FFT pricer for all strikes of one expiry
+*/
+
+#ifndef quantlib_fft_slice_pricer_hpp
+#define quantlib_fft_slice_pricer_hpp
+
+#include <ql/option.hpp>
+#include <ql/math/array.hpp>
+#include <ql/functional.hpp>
+#include <complex>
+#include <vector>
+
+namespace QuantLib {
+
+    class HestonModel;
+    class PiecewiseTimeDependentHestonModel;
+
+    //! Carr-Madan FFT pricer for a slice of European options
+    /*! The pricer takes the characteristic function of
+        \f$ \ln(S_T/F_T) \f$ of any model, \f$ F_T \f$ being the
+        forward of the expiry \f$ T \f$, and computes the prices of
+        European options for all given strikes of this expiry with a
+        single fast Fourier transform of size \f$ N = 2^{order} \f$.
+        Option prices between the points of the log-strike grid
+        are interpolated using a natural cubic spline.
+
+        Calibrating a model to a volatility surface therefore needs
+        one transform per expiry instead of one numerical integration
+        per option.
+
+        The log-strike grid covers \f$ [-N\lambda/2, N\lambda/2) \f$
+        around the forward, \f$ \lambda \f$ being the log-strike
+        spacing; the spacing of the integration grid is
+        \f$ 2\pi/(N\lambda) \f$.
+
+        References:
+        Carr, P. and D. B. Madan (1998),
+        "Option Valuation using the fast Fourier transform,"
+        Journal of Computational Finance, 2, 61-73.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the semi-analytic Heston engine.
+    */
+    class FFTSlicePricer {
+      public:
+        typedef ext::function<std::complex<Real>(const std::complex<Real>&)>
+            CharacteristicFunction;
+
+        explicit FFTSlicePricer(Size order = 13,
+                                Real logStrikeSpacing = 0.005,
+                                Real alpha = 1.25);
+
+        //! undiscounted call prices divided by the forward
+        /*! The result is given on the log-moneyness grid
+            \f$ k_i = \ln(K_i/F_T) = -N\lambda/2 + i\lambda \f$.
+        */
+        Disposable<Array> normalizedCallPrices(
+                                    const CharacteristicFunction& phi) const;
+
+        Disposable<Array> prices(const CharacteristicFunction& phi,
+                                 Option::Type type,
+                                 Real forward,
+                                 DiscountFactor discount,
+                                 const std::vector<Real>& strikes) const;
+
+        Disposable<Array> prices(const CharacteristicFunction& phi,
+                                 const std::vector<Option::Type>& types,
+                                 Real forward,
+                                 DiscountFactor discount,
+                                 const std::vector<Real>& strikes) const;
+
+        Size order() const { return order_; }
+        Real logStrikeSpacing() const { return lambda_; }
+
+        //! characteristic function of the Heston or Bates model
+        static CharacteristicFunction characteristicFunction(
+                                    const ext::shared_ptr<HestonModel>& model,
+                                    Time t);
+
+        //! characteristic function of the piecewise time dependent
+        //! Heston model
+        static CharacteristicFunction characteristicFunction(
+            const ext::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
+            Time t);
+
+      private:
+        const Size order_;
+        const Real lambda_, alpha_;
+    };
+
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include <ql/termstructures/volatility/atmsmilesection.hpp>
 #include <ql/termstructures/volatility/flatsmilesection.hpp>
 #include <ql/termstructures/volatility/gaussian1dsmilesection.hpp>
+#include <ql/termstructures/volatility/griddedsmilesection.hpp>
 #include <ql/termstructures/volatility/interpolatedsmilesection.hpp>
 #include <ql/termstructures/volatility/kahalesmilesection.hpp>
 #include <ql/termstructures/volatility/sabr.hpp>
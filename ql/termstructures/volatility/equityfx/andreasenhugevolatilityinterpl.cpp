@@ -42,6 +42,7 @@
 #include <boost/math/special_functions/fpclassify.hpp>
 
 #include <limits>
+#include <string>
 
 namespace QuantLib {
 
@@ -81,7 +82,57 @@ namespace QuantLib {
           dxxMap_(SecondDerivativeOp(0, mesher_)),
           d2CdK2_(dxMap_.mult(Array(mesher->layout()->size(), -1.0))
                         .add(dxxMap_)),
-          mapT_  (0, mesher_) {
+          mapT_  (0, mesher_),
+          volWeights_(nGridPoints_, lnMarketStrikes_.size()) {
+
+            // All interpolation types are linear in the volatilities
+            // at the market strikes; the weights of each of them on
+            // the grid are calculated once.
+            const Size n = lnMarketStrikes_.size();
+            Array x(n);
+            if (interpolationType_
+                    == AndreasenHugeVolatilityInterpl::PiecewiseConstant) {
+                for (Size i=0; i < n-1; ++i)
+                    x[i] = 0.5*(lnMarketStrikes_[i] + lnMarketStrikes_[i+1]);
+                x.back() = lnMarketStrikes_.back();
+            }
+
+            const ext::shared_ptr<FdmLinearOpLayout> layout =
+                mesher_->layout();
+            const FdmLinearOpIterator endIter = layout->end();
+
+            for (Size j=0; j < n; ++j) {
+                Array unit(n, 0.0);
+                unit[j] = 1.0;
+
+                Interpolation sigInterpl;
+                switch (interpolationType_) {
+                  case AndreasenHugeVolatilityInterpl::CubicSpline:
+                    sigInterpl = CubicNaturalSpline(
+                        lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
+                        unit.begin());
+                    break;
+                  case AndreasenHugeVolatilityInterpl::Linear:
+                    sigInterpl = LinearInterpolation(
+                        lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
+                        unit.begin());
+                    break;
+                  case AndreasenHugeVolatilityInterpl::PiecewiseConstant:
+                    sigInterpl = BackwardFlatInterpolation(
+                        x.begin(), x.end(), unit.begin());
+                    break;
+                  default:
+                    QL_FAIL("unknown interpolation type");
+                }
+
+                for (FdmLinearOpIterator iter = layout->begin();
+                     iter!=endIter; ++iter) {
+                    const Real lnStrike = mesher_->location(iter, 0);
+                    volWeights_[iter.index()][j] = sigInterpl(
+                        std::min(std::max(lnStrike, lnMarketStrikes_.front()),
+                                 lnMarketStrikes_.back()), true);
+                }
+            }
         }
 
         Disposable<Array> d2CdK2(const Array& c) const {
@@ -91,52 +142,65 @@ namespace QuantLib {
         Disposable<Array> solveFor(
             Time dT, const Array& sig, const Array& b) const {
 
-            Array x(lnMarketStrikes_.size());
-            Interpolation sigInterpl;
-
-            switch (interpolationType_) {
-              case AndreasenHugeVolatilityInterpl::CubicSpline:
-                sigInterpl = CubicNaturalSpline(
-                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
-                    sig.begin());
-                break;
-              case AndreasenHugeVolatilityInterpl::Linear:
-                sigInterpl = LinearInterpolation(
-                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
-                    sig.begin());
-                break;
-              case AndreasenHugeVolatilityInterpl::PiecewiseConstant:
-                for (Size i=0; i < x.size()-1; ++i)
-                    x[i] = 0.5*(lnMarketStrikes_[i] + lnMarketStrikes_[i+1]);
-                x.back() = lnMarketStrikes_.back();
+            const Array vol = volWeights_*sig;
+            const Array z = 0.5*vol*vol;
 
-                sigInterpl = BackwardFlatInterpolation(
-                    x.begin(), x.end(), sig.begin());
-                break;
-              default:
-                QL_FAIL("unknown interpolation type");
-            }
+            mapT_.axpyb(z, dxMap_, dxxMap_.mult(-z), Array());
+            return mapT_.mult(Array(z.size(), dT)).solve_splitting(b, 1.0);
+        }
 
-            const ext::shared_ptr<FdmLinearOpLayout> layout =
-                mesher_->layout();
-            const FdmLinearOpIterator endIter = layout->end();
+        /* The prices c on the grid solve (1 + dT diag(z) D) c = p,
+           with z = vol^2/2 and D = dx - dxx; differentiating gives
 
-            Array z(layout->size());
-            for (FdmLinearOpIterator iter = layout->begin();
-                 iter!=endIter; ++iter) {
-                const Size i = iter.index();
-                const Real lnStrike = mesher_->location(iter, 0);
+               dc/dsig_j = -(1 + dT diag(z) D)^{-1} dT (dz/dsig_j) D c
 
-                const Real vol = sigInterpl(
-                    std::min(std::max(lnStrike, lnMarketStrikes_.front()),
-                            lnMarketStrikes_.back()), true);
+           with dz/dsig_j = vol volWeights_[.][j].  The operator is
+           factorised once for all columns, which are independent.
+           Only the monotonic spline interpolating the prices at the
+           market strikes is differentiated numerically. */
+        void jacobian(Matrix& jac, const Array& sig) const {
+            const Size n = sig.size();
+            const Array vol = volWeights_*sig;
+            const Array c = solveFor(dT_, sig, previousNPVs_);
+            const Array y = dxMap_.apply(c) - dxxMap_.apply(c);
 
-                z[i] = 0.5*vol*vol;
-            }
-
-            mapT_.axpyb(z, dxMap_, dxxMap_.mult(-z), Array());
-            return mapT_.mult(Array(z.size(), dT)).solve_splitting(b, 1.0);
+            const TripleBandLinearOp implicitStep(
+                mapT_.mult(Array(nGridPoints_, dT_)));
+            implicitStep.factorize(1.0);
 
+            const std::vector<Real>& gridPoints =
+                mesher_->getFdm1dMeshers().front()->locations();
+            const MonotonicCubicNaturalSpline interpl(
+                gridPoints.begin(), gridPoints.end(), c.begin());
+            Array npvs(n);
+            for (Size i=0; i < n; ++i)
+                npvs[i] = interpl(lnMarketStrikes_[i]);
+
+            const Real h = 1e-6;
+            std::vector<std::string> errors(n);
+            #pragma omp parallel for
+            for (long j=0; j < long(n); ++j) {
+                try {
+                    Array rhs(nGridPoints_);
+                    for (Size g=0; g < nGridPoints_; ++g)
+                        rhs[g] = -dT_*vol[g]*volWeights_[g][j]*y[g];
+
+                    const Array bumped =
+                        c + h*implicitStep.solve_splitting(rhs, 1.0);
+                    const MonotonicCubicNaturalSpline bumpedInterpl(
+                        gridPoints.begin(), gridPoints.end(),
+                        bumped.begin());
+
+                    for (Size i=0; i < n; ++i)
+                        jac[i][j] =
+                            (bumpedInterpl(lnMarketStrikes_[i]) - npvs[i])/h;
+                } catch (std::exception& e) {
+                    errors[j] = e.what();
+                }
+            }
+            for (Size j=0; j < n; ++j)
+                QL_REQUIRE(errors[j].empty(),
+                           "could not calculate jacobian: " << errors[j]);
         }
 
         Disposable<Array> apply(const Array& c) const {
@@ -183,6 +247,10 @@ namespace QuantLib {
         const TripleBandLinearOp dxxMap_;
         const TripleBandLinearOp d2CdK2_;
         mutable TripleBandLinearOp mapT_;
+
+        // volatilities on the grid are volWeights_ times those at
+        // the market strikes
+        Matrix volWeights_;
     };
 
     class CombinedCostFunction : public CostFunction {
@@ -212,6 +280,24 @@ namespace QuantLib {
                 QL_FAIL("internal error: cost function not set");
         }
 
+        void jacobian(Matrix& jac, const Array& sig) const {
+            if (putCostFct_ && callCostFct_) {
+                const Size n = sig.size();
+                Matrix pj(n, n), cj(n, n);
+                putCostFct_->jacobian(pj, sig);
+                callCostFct_->jacobian(cj, sig);
+
+                std::copy(pj.begin(), pj.end(), jac.begin());
+                std::copy(cj.begin(), cj.end(), jac.begin() + n*n);
+            }
+            else if (putCostFct_)
+                putCostFct_->jacobian(jac, sig);
+            else if (callCostFct_)
+                callCostFct_->jacobian(jac, sig);
+            else
+                QL_FAIL("internal error: cost function not set");
+        }
+
         Disposable<Array> initialValues() const {
             if (putCostFct_ && callCostFct_)
                 return 0.5*(  putCostFct_->initialValues()
@@ -398,6 +484,13 @@ namespace QuantLib {
         gridPoints_ = mesher_->locations(0);
         gridInFwd_ = Exp(gridPoints_)*spot_->value();
 
+        // the previous calibration, if any, is used as starting point
+        std::vector<Array> previousSigmas;
+        if (calibrationResults_.size() == expiries_.size()) {
+            for (Size i=0; i < calibrationResults_.size(); ++i)
+                previousSigmas.push_back(calibrationResults_[i].sigmas);
+        }
+
         localVolCache_.clear();
         calibrationResults_.clear();
 
@@ -425,8 +518,9 @@ namespace QuantLib {
             CombinedCostFunction costFunction(putCostFct, callCostFct);
 
             PositiveConstraint positiveConstraint;
-            Problem problem(costFunction,
-                positiveConstraint, costFunction.initialValues());
+            Problem problem(costFunction, positiveConstraint,
+                previousSigmas.empty() ? costFunction.initialValues()
+                                       : previousSigmas[i]);
 
             optimizationMethod_->minimize(problem, endCriteria_);
 
@@ -45,7 +45,14 @@ namespace QuantLib {
 
     //! Calibration of a local volatility surface to a sparse grid of options
 
-    /*! References:
+    /*! The cost functions provide an analytic Jacobian of the
+        calibration errors, which is used by a LevenbergMarquardt
+        optimizer created with useCostFunctionsJacobian set to true.
+        When the surface is recalculated, e.g., after a change of the
+        market quotes, the calibration of each expiry starts from the
+        previous solution.
+
+        References:
 
         Andreasen J., Huge B., 2010. Volatility Interpolation
         https://ssrn.com/abstract=1694972
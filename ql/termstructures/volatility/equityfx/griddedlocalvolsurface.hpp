@@ -0,0 +1,189 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file griddedlocalvolsurface.hpp
+    \brief Local volatility surface precomputed on a time/strike grid
+*/
+
+#ifndef quantlib_gridded_local_vol_surface_hpp
+#define quantlib_gridded_local_vol_surface_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/math/interpolations/interpolation2d.hpp>
+#include <ql/math/interpolations/bilinearinterpolation.hpp>
+#include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+#include <string>
+
+namespace QuantLib {
+
+    //! Local volatility surface precomputed on a grid
+    /*! The local volatility of the underlying surface (usually a
+        LocalVolSurface, whose Dupire formula needs several lookups
+        on the Black surface and on the rate curves for each call) is
+        evaluated once on the given grid of times and strikes; the
+        nodes are evaluated in parallel if OpenMP is enabled.  Other
+        values are interpolated in time and log-strike with the given
+        two-dimensional interpolator (e.g., Bilinear or Bicubic) and
+        extrapolated flat outside the grid.
+
+        The grid is recalculated lazily whenever the underlying
+        surface notifies a change, so that the class can replace the
+        underlying surface in local-volatility engines and processes.
+
+        \warning the local volatilities of the underlying surface
+                 are evaluated with extrapolation enabled; its
+                 failures on any node, e.g., negative local variances
+                 in the wings, are reported when the grid is built.
+                 NoExceptLocalVolSurface can be used to avoid them.
+    */
+    template <class Interpolator2D = Bilinear>
+    class GriddedLocalVolSurface : public LocalVolTermStructure,
+                                   public LazyObject {
+      public:
+        GriddedLocalVolSurface(
+                    const Handle<LocalVolTermStructure>& localVol,
+                    const std::vector<Time>& times,
+                    const std::vector<Real>& strikes,
+                    const Interpolator2D& interpolator = Interpolator2D());
+        //! \name TermStructure interface
+        //@{
+        const Date& referenceDate() const {
+            return localVol_->referenceDate();
+        }
+        DayCounter dayCounter() const { return localVol_->dayCounter(); }
+        Date maxDate() const { return localVol_->maxDate(); }
+        //@}
+        //! \name VolatilityTermStructure interface
+        //@{
+        Real minStrike() const { return localVol_->minStrike(); }
+        Real maxStrike() const { return localVol_->maxStrike(); }
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Time>& times() const { return times_; }
+        const std::vector<Real>& strikes() const { return strikes_; }
+        //! local volatilities on the grid, one row per time
+        const Matrix& localVolMatrix() const;
+        //@}
+      protected:
+        void performCalculations() const;
+        Volatility localVolImpl(Time t, Real strike) const;
+      private:
+        Handle<LocalVolTermStructure> localVol_;
+        std::vector<Time> times_;
+        std::vector<Real> strikes_, logStrikes_;
+        Interpolator2D interpolator_;
+        mutable Matrix localVols_;
+        mutable Interpolation2D interpolation_;
+    };
+
+
+    // template definitions
+
+    template <class I2D>
+    GriddedLocalVolSurface<I2D>::GriddedLocalVolSurface(
+                             const Handle<LocalVolTermStructure>& localVol,
+                             const std::vector<Time>& times,
+                             const std::vector<Real>& strikes,
+                             const I2D& interpolator)
+    : LocalVolTermStructure(localVol->businessDayConvention(),
+                            localVol->dayCounter()),
+      localVol_(localVol), times_(times), strikes_(strikes),
+      logStrikes_(strikes.size()), interpolator_(interpolator),
+      localVols_(times.size(), strikes.size()) {
+        QL_REQUIRE(times_.size() >= 2, "at least two times required");
+        QL_REQUIRE(strikes_.size() >= 2, "at least two strikes required");
+        QL_REQUIRE(times_.front() >= 0.0,
+                   "negative time (" << times_.front() << ") given");
+        for (Size i=1; i<times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1],
+                       "times must be sorted and unique");
+        QL_REQUIRE(strikes_.front() > 0.0,
+                   "non-positive strike (" << strikes_.front() << ") given");
+        for (Size j=0; j<strikes_.size(); ++j) {
+            QL_REQUIRE(j == 0 || strikes_[j] > strikes_[j-1],
+                       "strikes must be sorted and unique");
+            logStrikes_[j] = std::log(strikes_[j]);
+        }
+        registerWith(localVol_);
+    }
+
+    template <class I2D>
+    void GriddedLocalVolSurface<I2D>::update() {
+        LocalVolTermStructure::update();
+        LazyObject::update();
+    }
+
+    template <class I2D>
+    const Matrix& GriddedLocalVolSurface<I2D>::localVolMatrix() const {
+        calculate();
+        return localVols_;
+    }
+
+    template <class I2D>
+    void GriddedLocalVolSurface<I2D>::performCalculations() const {
+        const Size nStrikes = strikes_.size();
+        const long nNodes = long(times_.size()*nStrikes);
+
+        // the first node is evaluated beforehand, so that any lazy
+        // calculation of the underlying surface is not triggered
+        // concurrently by the threads below
+        localVols_[0][0] =
+            localVol_->localVol(times_.front(), strikes_.front(), true);
+
+        std::vector<std::string> errors(nNodes);
+        #pragma omp parallel for
+        for (long n=1; n < nNodes; ++n) {
+            const Size i = Size(n)/nStrikes, j = Size(n)%nStrikes;
+            try {
+                localVols_[i][j] =
+                    localVol_->localVol(times_[i], strikes_[j], true);
+            } catch (std::exception& e) {
+                errors[n] = e.what();
+            }
+        }
+        for (long n=1; n < nNodes; ++n)
+            QL_REQUIRE(errors[n].empty(),
+                       "local volatility at time " << times_[n/nStrikes]
+                       << " and strike " << strikes_[n%nStrikes]
+                       << " not available: " << errors[n]);
+
+        interpolation_ = interpolator_.interpolate(
+                                   logStrikes_.begin(), logStrikes_.end(),
+                                   times_.begin(), times_.end(),
+                                   localVols_);
+    }
+
+    template <class I2D>
+    Volatility GriddedLocalVolSurface<I2D>::localVolImpl(Time t,
+                                                         Real strike) const {
+        calculate();
+        const Real x = std::min(std::max(std::log(strike),
+                                         logStrikes_.front()),
+                                logStrikes_.back());
+        const Time s = std::min(std::max(t, times_.front()), times_.back());
+        return interpolation_(x, s);
+    }
+
+}
+
+#endif
@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file griddedsmilesection.hpp
+    \brief Smile section precomputed on a strike grid
+*/
+
+#ifndef quantlib_gridded_smile_section_hpp
+#define quantlib_gridded_smile_section_hpp
+
+#include <ql/termstructures/volatility/smilesection.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Smile section precomputed on a strike grid
+    /*! The volatilities of the underlying section are evaluated once
+        on the given strikes, using its volatilities() method so that
+        sections providing a batch evaluation (e.g., SABR) can take
+        advantage of it.  Volatilities at strikes within the grid are
+        interpolated with the given interpolator; strikes outside the
+        grid are passed to the underlying section.
+
+        This is meant for clients, such as CMS replication pricers,
+        which query the same section many times.  The grid is
+        recalculated lazily whenever the underlying section notifies
+        a change.
+    */
+    template <class Interpolator = Cubic>
+    class GriddedSmileSection : public SmileSection,
+                                public LazyObject {
+      public:
+        GriddedSmileSection(const ext::shared_ptr<SmileSection>& source,
+                            const std::vector<Rate>& strikes,
+                            const Interpolator& interpolator = Interpolator());
+        //! \name SmileSection interface
+        //@{
+        Real minStrike() const { return source_->minStrike(); }
+        Real maxStrike() const { return source_->maxStrike(); }
+        Real atmLevel() const { return source_->atmLevel(); }
+        const Date& exerciseDate() const { return source_->exerciseDate(); }
+        Time exerciseTime() const { return source_->exerciseTime(); }
+        const DayCounter& dayCounter() const {
+            return source_->dayCounter();
+        }
+        const Date& referenceDate() const {
+            return source_->referenceDate();
+        }
+        VolatilityType volatilityType() const {
+            return source_->volatilityType();
+        }
+        Rate shift() const { return source_->shift(); }
+        //@}
+        //! \name Observer interface
+        //@{
+        void update() { LazyObject::update(); }
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Rate>& strikes() const { return strikes_; }
+        const std::vector<Volatility>& gridVolatilities() const;
+        //@}
+      protected:
+        void performCalculations() const;
+        Volatility volatilityImpl(Rate strike) const;
+      private:
+        ext::shared_ptr<SmileSection> source_;
+        std::vector<Rate> strikes_;
+        Interpolator interpolator_;
+        mutable std::vector<Volatility> vols_;
+        mutable Interpolation interpolation_;
+    };
+
+
+    // template definitions
+
+    template <class I>
+    GriddedSmileSection<I>::GriddedSmileSection(
+                               const ext::shared_ptr<SmileSection>& source,
+                               const std::vector<Rate>& strikes,
+                               const I& interpolator)
+    : source_(source), strikes_(strikes), interpolator_(interpolator) {
+        QL_REQUIRE(source_, "no underlying smile section given");
+        QL_REQUIRE(strikes_.size() >= I::requiredPoints,
+                   "at least " << I::requiredPoints
+                   << " strikes required, " << strikes_.size() << " given");
+        for (Size i=1; i<strikes_.size(); ++i)
+            QL_REQUIRE(strikes_[i] > strikes_[i-1],
+                       "strikes must be sorted and unique");
+        QL_REQUIRE(strikes_.front() >= source_->minStrike() &&
+                   strikes_.back() <= source_->maxStrike(),
+                   "strike grid [" << strikes_.front() << ", "
+                   << strikes_.back() << "] not within the range ["
+                   << source_->minStrike() << ", " << source_->maxStrike()
+                   << "] of the underlying smile section");
+        registerWith(source_);
+    }
+
+    template <class I>
+    const std::vector<Volatility>&
+    GriddedSmileSection<I>::gridVolatilities() const {
+        calculate();
+        return vols_;
+    }
+
+    template <class I>
+    void GriddedSmileSection<I>::performCalculations() const {
+        vols_ = source_->volatilities(strikes_);
+        interpolation_ = interpolator_.interpolate(strikes_.begin(),
+                                                   strikes_.end(),
+                                                   vols_.begin());
+    }
+
+    template <class I>
+    Volatility GriddedSmileSection<I>::volatilityImpl(Rate strike) const {
+        if (strike < strikes_.front() || strike > strikes_.back())
+            return source_->volatility(strike);
+        calculate();
+        return interpolation_(strike);
+    }
+
+}
+
+#endif
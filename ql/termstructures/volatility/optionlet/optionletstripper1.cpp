@@ -24,13 +24,13 @@
 
 #include <ql/termstructures/volatility/optionlet/optionletstripper1.hpp>
 #include <ql/instruments/makecapfloor.hpp>
-#include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
-#include <ql/pricingengine.hpp>
-#include <ql/pricingengines/capfloor/bacheliercapfloorengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/settings.hpp>
+#include <string>
 
 namespace QuantLib {
 
@@ -55,20 +55,38 @@ OptionletStripper1::OptionletStripper1(
 
     void OptionletStripper1::performCalculations() const {
 
+        QL_REQUIRE(volatilityType_ == ShiftedLognormal ||
+                   volatilityType_ == Normal,
+                   "unknown volatility type: " << volatilityType_);
+
         // update dates
         const Date& referenceDate = termVolSurface_->referenceDate();
         const DayCounter& dc = termVolSurface_->dayCounter();
-        ext::shared_ptr<BlackCapFloorEngine> dummy(new
-                    BlackCapFloorEngine(// discounting does not matter here
-                                        iborIndex_->forwardingTermStructure(),
-                                        0.20, dc));
+
+        const Handle<YieldTermStructure>& discountCurve =
+            discount_.empty() ?
+                iborIndex_->forwardingTermStructure() :
+                discount_;
+
+        // as in the cap/floor engines, paid caplets are discarded
+        // and volatilities are measured from today
+        const Date today = Settings::instance().evaluationDate();
+        const Date settlement = discountCurve->referenceDate();
+
+        /* The caplets of a cap do not depend on its strike; their
+           forwards, annuities and times to fixing are calculated once
+           for all strikes, and the caps are priced directly from them
+           instead of building an instrument for each strike. */
+        std::vector<std::vector<Rate> > capletForwards(nOptionletTenors_);
+        std::vector<std::vector<Real> > capletAnnuities(nOptionletTenors_);
+        std::vector<std::vector<Real> > capletSqrtTimes(nOptionletTenors_);
+
         for (Size i=0; i<nOptionletTenors_; ++i) {
             CapFloor temp = MakeCapFloor(CapFloor::Cap,
                                          capFloorLengths_[i],
                                          iborIndex_,
                                          0.04, // dummy strike
-                                         0*Days)
-                .withPricingEngine(dummy);
+                                         0*Days);
             ext::shared_ptr<FloatingRateCoupon> lFRC =
                                                 temp.lastFloatingRateCoupon();
             optionletDates_[i] = lFRC->fixingDate();
@@ -77,6 +95,23 @@ OptionletStripper1::OptionletStripper1(
             optionletTimes_[i] = dc.yearFraction(referenceDate,
                                                  optionletDates_[i]);
             atmOptionletRate_[i] = lFRC->indexFixing();
+
+            const Leg& leg = temp.floatingLeg();
+            for (Size k=0; k<leg.size(); ++k) {
+                ext::shared_ptr<FloatingRateCoupon> coupon =
+                    ext::dynamic_pointer_cast<FloatingRateCoupon>(leg[k]);
+                QL_REQUIRE(coupon, "non-FloatingRateCoupon given");
+                if (coupon->date() > settlement) {
+                    const Date fixingDate = coupon->fixingDate();
+                    capletForwards[i].push_back(coupon->adjustedFixing());
+                    capletAnnuities[i].push_back(
+                        coupon->nominal() * coupon->gearing() *
+                        discountCurve->discount(coupon->date()) *
+                        coupon->accrualPeriod());
+                    capletSqrtTimes[i].push_back(fixingDate > today ?
+                        std::sqrt(dc.yearFraction(today, fixingDate)) : 0.0);
+                }
+            }
         }
 
         if (floatingSwitchStrike_) {
@@ -87,89 +122,91 @@ OptionletStripper1::OptionletStripper1(
             switchStrike_ = averageAtmOptionletRate / nOptionletTenors_;
         }
 
-        const Handle<YieldTermStructure>& discountCurve =
-            discount_.empty() ?
-                iborIndex_->forwardingTermStructure() :
-                discount_;
+        std::vector<DiscountFactor> optionletAnnuities(nOptionletTenors_);
+        for (Size i=0; i<nOptionletTenors_; ++i)
+            optionletAnnuities[i] = optionletAccrualPeriods_[i] *
+                discountCurve->discount(optionletPaymentDates_[i]);
 
         const std::vector<Rate>& strikes = termVolSurface_->strikes();
 
-        ext::shared_ptr<PricingEngine> capFloorEngine;
-        ext::shared_ptr<SimpleQuote> volQuote(new SimpleQuote);
-
-        if (volatilityType_ == ShiftedLognormal) {
-            capFloorEngine = ext::make_shared<BlackCapFloorEngine>(
-                        
-                            discountCurve, Handle<Quote>(volQuote),
-                            dc, displacement_);
-        } else if (volatilityType_ == Normal) {
-            capFloorEngine = ext::make_shared<BachelierCapFloorEngine>(
-                        
-                            discountCurve, Handle<Quote>(volQuote),
-                            dc);
-        } else {
-            QL_FAIL("unknown volatility type: " << volatilityType_);
-        }
+        // the term volatility surface is read beforehand, so that its
+        // lazy calculation is not triggered concurrently below
+        for (Size i=0; i<nOptionletTenors_; ++i)
+            for (Size j=0; j<nStrikes_; ++j)
+                capFloorVols_[i][j] = termVolSurface_->volatility(
+                    capFloorLengths_[i], strikes[j], true);
 
-        for (Size j=0; j<nStrikes_; ++j) {
+        // strikes are stripped independently of each other
+        std::vector<std::string> errors(nStrikes_);
+        #pragma omp parallel for
+        for (long n=0; n<long(nStrikes_); ++n) {
+            const Size j = Size(n);
             // using out-of-the-money options
-            CapFloor::Type capFloorType =
-                strikes[j] < switchStrike_ ? CapFloor::Floor : CapFloor::Cap;
             Option::Type optionletType =
                 strikes[j] < switchStrike_ ? Option::Put : Option::Call;
 
-            Real previousCapFloorPrice = 0.0;
-            for (Size i=0; i<nOptionletTenors_; ++i) {
-
-                capFloorVols_[i][j] = termVolSurface_->volatility(
-                    capFloorLengths_[i], strikes[j], true);
-                volQuote->setValue(capFloorVols_[i][j]);
-                ext::shared_ptr<CapFloor> capFloor =
-                    MakeCapFloor(capFloorType, capFloorLengths_[i],
-                                 iborIndex_, strikes[j], -0 * Days)
-                        .withPricingEngine(capFloorEngine);
-                capFloorPrices_[i][j] = capFloor->NPV();
-                optionletPrices_[i][j] = capFloorPrices_[i][j] -
+            try {
+                Real previousCapFloorPrice = 0.0;
+                for (Size i=0; i<nOptionletTenors_; ++i) {
+
+                    Real capFloorPrice = 0.0;
+                    for (Size k=0; k<capletForwards[i].size(); ++k) {
+                        const Real stdDev =
+                            capFloorVols_[i][j]*capletSqrtTimes[i][k];
+                        if (volatilityType_ == ShiftedLognormal)
+                            capFloorPrice += blackFormula(
+                                optionletType, strikes[j],
+                                capletForwards[i][k], stdDev,
+                                capletAnnuities[i][k], displacement_);
+                        else
+                            capFloorPrice += bachelierBlackFormula(
+                                optionletType, strikes[j],
+                                capletForwards[i][k], stdDev,
+                                capletAnnuities[i][k]);
+                    }
+                    capFloorPrices_[i][j] = capFloorPrice;
+                    optionletPrices_[i][j] = capFloorPrices_[i][j] -
                                                         previousCapFloorPrice;
-                previousCapFloorPrice = capFloorPrices_[i][j];
-                DiscountFactor d =
-                    discountCurve->discount(optionletPaymentDates_[i]);
-                DiscountFactor optionletAnnuity=optionletAccrualPeriods_[i]*d;
-                try {
-                  if (volatilityType_ == ShiftedLognormal) {
-                    optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
-                        optionletType, strikes[j], atmOptionletRate_[i],
-                        optionletPrices_[i][j], optionletAnnuity, displacement_,
-                        optionletStDevs_[i][j], accuracy_, maxIter_);
-                  } else if (volatilityType_ == Normal) {
-                    optionletStDevs_[i][j] =
-                        std::sqrt(optionletTimes_[i]) *
-                        bachelierBlackFormulaImpliedVol(
+                    previousCapFloorPrice = capFloorPrices_[i][j];
+                    DiscountFactor optionletAnnuity = optionletAnnuities[i];
+                    try {
+                      if (volatilityType_ == ShiftedLognormal) {
+                        optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
                             optionletType, strikes[j], atmOptionletRate_[i],
-                            optionletTimes_[i], optionletPrices_[i][j],
-                            optionletAnnuity);
-                  } else {
-                    QL_FAIL("Unknown volatility type: " << volatilityType_);
-                  }
-                }
-                catch (std::exception &e) {
-                    if(dontThrow_)
-                        optionletStDevs_[i][j]=0.0;
-                    else
-                        QL_FAIL("could not bootstrap optionlet:"
-                            "\n type:    " << optionletType <<
-                            "\n strike:  " << io::rate(strikes[j]) <<
-                            "\n atm:     " << io::rate(atmOptionletRate_[i]) <<
-                            "\n price:   " << optionletPrices_[i][j] <<
-                            "\n annuity: " << optionletAnnuity <<
-                            "\n expiry:  " << optionletDates_[i] <<
-                            "\n error:   " << e.what());
-                }
-                optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
+                            optionletPrices_[i][j], optionletAnnuity,
+                            displacement_, optionletStDevs_[i][j],
+                            accuracy_, maxIter_);
+                      } else {
+                        optionletStDevs_[i][j] =
+                            std::sqrt(optionletTimes_[i]) *
+                            bachelierBlackFormulaImpliedVol(
+                                optionletType, strikes[j],
+                                atmOptionletRate_[i], optionletTimes_[i],
+                                optionletPrices_[i][j], optionletAnnuity);
+                      }
+                    }
+                    catch (std::exception &e) {
+                        if(dontThrow_)
+                            optionletStDevs_[i][j]=0.0;
+                        else
+                            QL_FAIL("could not bootstrap optionlet:"
+                                "\n type:    " << optionletType <<
+                                "\n strike:  " << io::rate(strikes[j]) <<
+                                "\n atm:     " << io::rate(atmOptionletRate_[i]) <<
+                                "\n price:   " << optionletPrices_[i][j] <<
+                                "\n annuity: " << optionletAnnuity <<
+                                "\n expiry:  " << optionletDates_[i] <<
+                                "\n error:   " << e.what());
+                    }
+                    optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
                                                 std::sqrt(optionletTimes_[i]);
+                }
+            } catch (std::exception& e) {
+                errors[j] = e.what();
             }
         }
-
+        for (Size j=0; j<nStrikes_; ++j)
+            QL_REQUIRE(errors[j].empty(), errors[j]);
     }
 
     const Matrix &OptionletStripper1::capletVols() const {
@@ -28,6 +28,7 @@
 #include <ql/instruments/makecapfloor.hpp>
 #include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
 #include <ql/indexes/iborindex.hpp>
+#include <string>
 
 
 namespace QuantLib {
@@ -125,16 +126,38 @@ namespace QuantLib {
 
     std::vector<Volatility> OptionletStripper2::spreadsVolImplied() const {
 
-        Brent solver;
         std::vector<Volatility> result(nOptionExpiries_);
         Volatility guess = 0.0001, minSpread = -0.1, maxSpread = 0.1;
+
+        // the objective functions are set up beforehand, since they
+        // register with the shared curves and volatilities; their
+        // first evaluation also performs the lazy calculations of
+        // the underlying structures.
+        std::vector<ext::shared_ptr<ObjectiveFunction> > f(nOptionExpiries_);
         for (Size j=0; j<nOptionExpiries_; ++j) {
-            ObjectiveFunction f(stripper1_, caps_[j], atmCapFloorPrices_[j]);
-            solver.setMaxEvaluations(maxEvaluations_);
-            Volatility root = solver.solve(f, accuracy_, guess,
-                                           minSpread, maxSpread);
-            result[j] = root;
+            f[j] = ext::make_shared<ObjectiveFunction>(
+                          stripper1_, caps_[j], atmCapFloorPrices_[j]);
+            (*f[j])(guess);
+        }
+
+        // each expiry is solved independently
+        std::vector<std::string> errors(nOptionExpiries_);
+        #pragma omp parallel for
+        for (long n=0; n<long(nOptionExpiries_); ++n) {
+            try {
+                Brent solver;
+                solver.setMaxEvaluations(maxEvaluations_);
+                result[n] = solver.solve(*f[n], accuracy_, guess,
+                                         minSpread, maxSpread);
+            } catch (std::exception& e) {
+                errors[n] = e.what();
+            }
         }
+        for (Size j=0; j<nOptionExpiries_; ++j)
+            QL_REQUIRE(errors[j].empty(),
+                       "could not imply spread for expiry "
+                       << atmCapFloorTermVolCurve_->optionTenors()[j]
+                       << ": " << errors[j]);
         return result;
     }
 
@@ -83,6 +83,57 @@ namespace QuantLib {
 
     }
 
+    void unsafeShiftedSabrVolatilities(const std::vector<Rate>& strikes,
+                                       Rate forward,
+                                       Time expiryTime,
+                                       Real alpha,
+                                       Real beta,
+                                       Real nu,
+                                       Real rho,
+                                       Real shift,
+                                       std::vector<Real>& volatilities) {
+        const Real f = forward+shift;
+        const Real oneMinusBeta = 1.0-beta;
+        const Real logF = std::log(f);
+        const Real nuOverAlpha = nu/alpha;
+        const Real c1 =
+            expiryTime*oneMinusBeta*oneMinusBeta*alpha*alpha/24.0;
+        const Real c2 = expiryTime*0.25*rho*beta*nu*alpha;
+        const Real c3 = 1.0 + expiryTime*(2.0-3.0*rho*rho)*(nu*nu/24.0);
+        static const Real m = 10;
+
+        volatilities.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real k = strikes[i]+shift;
+            const Real logK = std::log(k);
+            // (f k)^(1-beta), reusing the logarithm of the strike
+            const Real A = std::exp(oneMinusBeta*(logF+logK));
+            const Real sqrtA = std::sqrt(A);
+            Real logM;
+            if (!close(f, k))
+                logM = logF - logK;
+            else {
+                const Real epsilon = (f-k)/k;
+                logM = epsilon - .5 * epsilon * epsilon ;
+            }
+            const Real z = nuOverAlpha*sqrtA*logM;
+            const Real B = 1.0-2.0*rho*z+z*z;
+            const Real C = oneMinusBeta*oneMinusBeta*logM*logM;
+            const Real tmp = (std::sqrt(B)+z-rho)/(1.0-rho);
+            const Real xx = std::log(tmp);
+            const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
+            const Real d = c3 + c1/A + c2/sqrtA;
+
+            Real multiplier;
+            if (std::fabs(z*z)>QL_EPSILON * m)
+                multiplier = z/xx;
+            else {
+                multiplier = 1.0 - 0.5*rho*z - (3.0*rho*rho-2.0)*z*z/12.0;
+            }
+            volatilities[i] = (alpha/D)*multiplier*d;
+        }
+    }
+
     void validateSabrParameters(Real alpha,
                                 Real beta,
                                 Real nu,
@@ -29,6 +29,7 @@
 #define quantlib_sabr_hpp
 
 #include <ql/types.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -49,6 +50,18 @@ namespace QuantLib {
                               Real rho,
                               Real shift);
 
+    /*! Hagan's formula evaluated on several strikes; the terms not
+        depending on the strike are calculated once. */
+    void unsafeShiftedSabrVolatilities(const std::vector<Rate>& strikes,
+                                       Rate forward,
+                                       Time expiryTime,
+                                       Real alpha,
+                                       Real beta,
+                                       Real nu,
+                                       Real rho,
+                                       Real shift,
+                                       std::vector<Real>& volatilities);
+
     Real sabrVolatility(Rate strike,
                         Rate forward,
                         Time expiryTime,
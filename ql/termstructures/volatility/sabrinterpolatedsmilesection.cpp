@@ -22,6 +22,8 @@
 #include <ql/termstructures/volatility/sabrinterpolatedsmilesection.hpp>
 #include <ql/settings.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/volatility/sabr.hpp>
+#include <ql/utilities/dataformatters.hpp>
 
 namespace QuantLib {
 
@@ -128,5 +130,22 @@ namespace QuantLib {
         return v*v*exerciseTime();
     }
 
+    void SabrInterpolatedSmileSection::volatilitiesImpl(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Volatility>& vols) const {
+        calculate();
+        for (Size i=0; i<strikes.size(); ++i)
+            QL_REQUIRE(strikes[i] + shift() > 0.0,
+                       "strike+shift must be positive: "
+                       << io::rate(strikes[i]) << "+" << io::rate(shift())
+                       << " not allowed");
+        unsafeShiftedSabrVolatilities(strikes, forwardValue_, exerciseTime(),
+                                      sabrInterpolation_->alpha(),
+                                      sabrInterpolation_->beta(),
+                                      sabrInterpolation_->nu(),
+                                      sabrInterpolation_->rho(),
+                                      shift(), vols);
+    }
+
 }
 
@@ -92,6 +92,8 @@ namespace QuantLib {
         //@}
         Real varianceImpl(Rate strike) const;
         Volatility volatilityImpl(Rate strike) const;
+        void volatilitiesImpl(const std::vector<Rate>& strikes,
+                              std::vector<Volatility>& vols) const;
          //! \name Inspectors
         //@{
         Real alpha() const;
@@ -78,4 +78,14 @@ namespace QuantLib {
         return unsafeShiftedSabrVolatility(strike, forward_, exerciseTime(),
                                            alpha_, beta_, nu_, rho_, shift_);
      }
+
+     void SabrSmileSection::volatilitiesImpl(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Volatility>& vols) const {
+        std::vector<Rate> k(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            k[i] = std::max(0.00001 - shift(), strikes[i]);
+        unsafeShiftedSabrVolatilities(k, forward_, exerciseTime(),
+                                      alpha_, beta_, nu_, rho_, shift_, vols);
+     }
 }
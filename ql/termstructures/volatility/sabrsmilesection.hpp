@@ -48,6 +48,8 @@ namespace QuantLib {
       protected:
         Real varianceImpl(Rate strike) const;
         Volatility volatilityImpl(Rate strike) const;
+        void volatilitiesImpl(const std::vector<Rate>& strikes,
+                              std::vector<Volatility>& vols) const;
       private:
         Real alpha_, beta_, nu_, rho_, forward_, shift_;
     };
@@ -30,6 +30,7 @@
 #include <ql/utilities/null.hpp>
 #include <ql/option.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -56,6 +57,9 @@ namespace QuantLib {
         virtual Real maxStrike() const = 0;
         Real variance(Rate strike) const;
         Volatility volatility(Rate strike) const;
+        //! volatilities at several strikes at once
+        std::vector<Volatility> volatilities(
+                                    const std::vector<Rate>& strikes) const;
         virtual Real atmLevel() const = 0;
         virtual const Date& exerciseDate() const { return exerciseDate_; }
         virtual VolatilityType volatilityType() const {
@@ -82,6 +86,11 @@ namespace QuantLib {
         virtual void initializeExerciseTime() const;
         virtual Real varianceImpl(Rate strike) const;
         virtual Volatility volatilityImpl(Rate strike) const = 0;
+        /*! The default implementation calls volatilityImpl() for each
+            strike; derived classes can override it when the smile
+            can be evaluated more efficiently on many strikes. */
+        virtual void volatilitiesImpl(const std::vector<Rate>& strikes,
+                                      std::vector<Volatility>& vols) const;
       private:
         bool isFloating_;
         mutable Date referenceDate_;
@@ -103,6 +112,20 @@ namespace QuantLib {
         return volatilityImpl(strike);
     }
 
+    inline std::vector<Volatility> SmileSection::volatilities(
+                                    const std::vector<Rate>& strikes) const {
+        std::vector<Volatility> vols(strikes.size());
+        volatilitiesImpl(strikes, vols);
+        return vols;
+    }
+
+    inline void SmileSection::volatilitiesImpl(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Volatility>& vols) const {
+        for (Size i=0; i<strikes.size(); ++i)
+            vols[i] = volatilityImpl(strikes[i]);
+    }
+
     inline const Date& SmileSection::referenceDate() const {
         QL_REQUIRE(referenceDate_!=Date(),
                    "referenceDate not available for this instance");
@@ -161,6 +161,18 @@ namespace QuantLib {
                            const std::vector<Real> &beta,
                            const Period& swapTenor);
         void updateAfterRecalibration();
+        //! \name Calibration settings
+        //@{
+        /*! If enabled, nodes whose market data changed are calibrated
+            starting from their last calibrated parameters instead of
+            the parameter guess, which usually needs far fewer
+            iterations after small market moves.  The resulting
+            parameters may differ from a calibration started from the
+            guess within the calibration tolerance.
+        */
+        void enableWarmStart(bool enable = true) { warmStart_ = enable; }
+        bool warmStartEnabled() const { return warmStart_; }
+        //@}
      protected:
         void registerWithParametersGuess();
         void setParameterGuess() const;
@@ -174,11 +186,29 @@ namespace QuantLib {
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
                                                  const Period& atmSwapTenor) const;
       private:
+        // inputs and results of the calibration of a single node
+        struct CalibratedNode {
+            Time optionTime;
+            Rate forward;
+            Real shift;
+            std::vector<Real> strikes, volatilities, guess;
+            // alpha, beta, nu, rho, forward, rms error, max error
+            // and end criteria; empty if not calibrated
+            std::vector<Real> result;
+            bool hasSameInputs(const CalibratedNode& o) const {
+                return optionTime == o.optionTime && forward == o.forward &&
+                       shift == o.shift && strikes == o.strikes &&
+                       volatilities == o.volatilities && guess == o.guess;
+            }
+        };
+        Cube sabrCalibration(const Cube &marketVolCube,
+                             std::vector<CalibratedNode>& nodes) const;
         Size requiredNumberOfStrikes() const { return 1; }
         mutable Cube marketVolCube_;
         mutable Cube volCubeAtmCalibrated_;
         mutable Cube sparseParameters_;
         mutable Cube denseParameters_;
+        mutable std::vector<CalibratedNode> sparseNodes_, denseNodes_;
         mutable std::vector< std::vector<ext::shared_ptr<SmileSection> > >
                                                                 sparseSmiles_;
         std::vector<std::vector<Handle<Quote> > > parametersGuessQuotes_;
@@ -193,6 +223,7 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        bool warmStart_;
 
         class PrivateObserver : public Observer {
           public:
@@ -239,7 +270,8 @@ namespace QuantLib {
           isAtmCalibrated_(isAtmCalibrated), endCriteria_(endCriteria),
           optMethod_(optMethod),
           useMaxError_(useMaxError), maxGuesses_(maxGuesses),
-          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike) {
+          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike),
+          warmStart_(false) {
 
         // the current implementations are all lognormal, if we have
         // a normal one, we can move this check to the implementing classes
@@ -310,7 +342,7 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_, sparseNodes_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -318,7 +350,8 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseNodes_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -327,7 +360,8 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseNodes_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
@@ -336,12 +370,29 @@ namespace QuantLib {
     template <class Model>
     typename SwaptionVolCube1x<Model>::Cube
     SwaptionVolCube1x<Model>::sabrCalibration(const Cube &marketVolCube) const {
+        std::vector<CalibratedNode> nodes;
+        return sabrCalibration(marketVolCube, nodes);
+    }
+
+    /*! Calibrates the SABR parameters of all nodes of the cube.  The
+        results of the last calibration are passed in nodes; a node
+        whose market data and parameter guess did not change keeps its
+        parameters.  The other nodes are calibrated concurrently if the
+        library is compiled with OpenMP support, unless an optimization
+        method was given, since the latter is shared by all nodes.
+    */
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::Cube
+    SwaptionVolCube1x<Model>::sabrCalibration(
+                                const Cube &marketVolCube,
+                                std::vector<CalibratedNode>& nodes) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
         const std::vector<Date>& optionDates = marketVolCube.optionDates();
         const std::vector<Period>& swapTenors = marketVolCube.swapTenors();
-        Matrix alphas(optionTimes.size(), swapLengths.size(),0.);
+        const Size nOptions = optionTimes.size(), nSwaps = swapLengths.size();
+        Matrix alphas(nOptions, nSwaps, 0.);
         Matrix betas(alphas);
         Matrix nus(alphas);
         Matrix rhos(alphas);
@@ -352,31 +403,51 @@ namespace QuantLib {
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
-
-        for (Size j=0; j<optionTimes.size(); j++) {
-            for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
+        // the market data are collected beforehand, since neither the
+        // swap indexes nor the atm volatility structure can be used
+        // from several threads
+        const bool sameGrid = nodes.size() == nOptions*nSwaps;
+        std::vector<CalibratedNode> current(nOptions*nSwaps);
+        for (Size j=0; j<nOptions; j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                CalibratedNode& node = current[j*nSwaps+k];
+                node.optionTime = optionTimes[j];
+                node.forward = atmStrike(optionDates[j], swapTenors[k]);
+                node.shift = atmVol_->shift(optionTimes[j], swapLengths[k]);
                 for (Size i=0; i<nStrikes_; i++){
-                    Real strike = atmForward+strikeSpreads_[i];
-                    if(strike + shiftTmp >=cutoffStrike_) {
-                        strikes.push_back(strike);
-                        volatilities.push_back(tmpMarketVolCube[i][j][k]);
+                    Real strike = node.forward+strikeSpreads_[i];
+                    if(strike + node.shift >=cutoffStrike_) {
+                        node.strikes.push_back(strike);
+                        node.volatilities.push_back(tmpMarketVolCube[i][j][k]);
                     }
                 }
+                node.guess = parametersGuess_(optionTimes[j], swapLengths[k]);
+                if (sameGrid && nodes[j*nSwaps+k].hasSameInputs(node))
+                    node.result = nodes[j*nSwaps+k].result;
+            }
+        }
 
-                const std::vector<Real>& guess =
-                    parametersGuess_(optionTimes[j], swapLengths[k]);
+        std::vector<std::string> failures(current.size());
+
+        #pragma omp parallel for if(!optMethod_)
+        for (long n=0; n<long(current.size()); ++n) {
+            CalibratedNode& node = current[n];
+            if (!node.result.empty())
+                continue;
+            try {
+                std::vector<Real> guess = node.guess;
+                if (warmStart_ && sameGrid && !nodes[n].result.empty()
+                    && nodes[n].guess == node.guess) {
+                    for (Size i=0; i<4; i++)
+                        if (!isParameterFixed_[i])
+                            guess[i] = nodes[n].result[i];
+                }
 
                 const ext::shared_ptr<typename Model::Interpolation> sabrInterpolation =
                     ext::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
+                                          (typename Model::Interpolation)(node.strikes.begin(), node.strikes.end(),
+                                          node.volatilities.begin(),
+                                          node.optionTime, node.forward,
                                           guess[0], guess[1],
                                           guess[2], guess[3],
                                           isParameterFixed_[0],
@@ -389,19 +460,42 @@ namespace QuantLib {
                                           errorAccept_,
                                           useMaxError_,
                                           maxGuesses_,
-                                          shiftTmp));
+                                          node.shift));
                 sabrInterpolation->update();
 
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
+                std::vector<Real> result(8);
+                result[0] = sabrInterpolation->alpha();
+                result[1] = sabrInterpolation->beta();
+                result[2] = sabrInterpolation->nu();
+                result[3] = sabrInterpolation->rho();
+                result[4] = node.forward;
+                result[5] = sabrInterpolation->rmsError();
+                result[6] = sabrInterpolation->maxError();
+                result[7] = sabrInterpolation->endCriteria();
+                node.result.swap(result);
+            } catch (std::exception& e) {
+                failures[n] = e.what();
+            }
+        }
+
+        for (Size j=0; j<nOptions; j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                QL_REQUIRE(failures[j*nSwaps+k].empty(),
+                           "global swaptions calibration failed: "
+                           "option maturity = " << optionDates[j] <<
+                           ", swap tenor = " << swapTenors[k] << ": " <<
+                           failures[j*nSwaps+k]);
+                const std::vector<Real>& result = current[j*nSwaps+k].result;
+                Real rmsError = result[5];
+                Real maxError = result[6];
+                alphas     [j][k] = result[0];
+                betas      [j][k] = result[1];
+                nus        [j][k] = result[2];
+                rhos       [j][k] = result[3];
+                forwards   [j][k] = result[4];
                 errors     [j][k] = rmsError;
                 maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+                endCriteria[j][k] = result[7];
 
                 QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
@@ -432,6 +526,8 @@ namespace QuantLib {
                               << "   rho = " << rhos[j][k] << "\n");
             }
         }
+        nodes.swap(current);
+
         Cube sabrParametersCube(optionDates, swapTenors,
                                 optionTimes, swapLengths, 8,
                                 true, backwardFlat_);
@@ -22,9 +22,110 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    Calendar::BusinessDayCache::BusinessDayCache(
+                           Year firstYear, Year lastYear,
+                           const boost::dynamic_bitset<>& businessDays)
+    : firstYear_(firstYear), lastYear_(lastYear),
+      first_(Date(1, January, firstYear).serialNumber()),
+      businessDays_(businessDays), counts_(businessDays.size()+1, 0) {
+        QL_REQUIRE(first_ + Date::serial_type(businessDays_.size())
+                   == Date(31, December, lastYear).serialNumber() + 1,
+                   "wrong number of days for the cached range");
+        for (Size i=0; i<businessDays_.size(); ++i)
+            counts_[i+1] = counts_[i] + (businessDays_[i] ? 1 : 0);
+    }
+
+    void Calendar::BusinessDayCache::set(const Date& d, bool isBusinessDay) {
+        Size i = d.serialNumber() - first_;
+        if (businessDays_[i] == isBusinessDay)
+            return;
+        businessDays_[i] = isBusinessDay;
+        const Date::serial_type delta = isBusinessDay ? 1 : -1;
+        for (Size j=i+1; j<counts_.size(); ++j)
+            counts_[j] += delta;
+    }
+
+    boost::dynamic_bitset<> Calendar::BusinessDayCache::businessDays(
+                                           const Date& from, Size n) const {
+        boost::dynamic_bitset<> result =
+            businessDays_ >> Size(from.serialNumber() - first_);
+        result.resize(n);
+        return result;
+    }
+
+    boost::dynamic_bitset<> Calendar::Impl::businessDays(const Date& from,
+                                                         Size n) const {
+        boost::dynamic_bitset<> result(n);
+        Date d = from;
+        for (Size i=0; i<n; ++i, ++d)
+            result[i] = isBusinessDay(d);
+        return result;
+    }
+
+    boost::dynamic_bitset<> Calendar::businessDays(const Date& from,
+                                                   const Date& to) const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        QL_REQUIRE(from != Date() && to != Date(), "null date");
+        QL_REQUIRE(from <= to, "'from' date (" << from
+                   << ") must not be later than 'to' date (" << to << ")");
+
+#ifdef QL_HIGH_RESOLUTION_DATE
+        const Date _from(from.dayOfMonth(), from.month(), from.year());
+        const Date _to(to.dayOfMonth(), to.month(), to.year());
+#else
+        const Date& _from = from;
+        const Date& _to = to;
+#endif
+
+        const Size n = _to - _from + 1;
+        if (impl_->cache && impl_->cache->covers(_from)
+                         && impl_->cache->covers(_to))
+            return impl_->cache->businessDays(_from, n);
+
+        boost::dynamic_bitset<> result = impl_->businessDays(_from, n);
+        std::set<Date>::const_iterator i;
+        for (i = impl_->addedHolidays.lower_bound(_from);
+             i != impl_->addedHolidays.end() && *i <= _to; ++i)
+            result[*i - _from] = false;
+        for (i = impl_->removedHolidays.lower_bound(_from);
+             i != impl_->removedHolidays.end() && *i <= _to; ++i)
+            result[*i - _from] = true;
+        return result;
+    }
+
+    void Calendar::enableCache(Year firstYear, Year lastYear) {
+        QL_REQUIRE(impl_, "no implementation provided");
+        QL_REQUIRE(firstYear <= lastYear,
+                   "first year (" << firstYear
+                   << ") must not be later than last year ("
+                   << lastYear << ")");
+        QL_REQUIRE(firstYear >= Date::minDate().year()
+                   && lastYear <= Date::maxDate().year(),
+                   "cached years must be between "
+                   << Date::minDate().year() << " and "
+                   << Date::maxDate().year());
+        // the business days must be computed from the rules
+        impl_->cache.reset();
+        impl_->cache = ext::make_shared<BusinessDayCache>(
+            firstYear, lastYear,
+            businessDays(Date(1, January, firstYear),
+                         Date(31, December, lastYear)));
+    }
+
+    void Calendar::disableCache() {
+        QL_REQUIRE(impl_, "no implementation provided");
+        impl_->cache.reset();
+    }
+
+    void Calendar::refreshCache() {
+        if (impl_ && impl_->cache)
+            enableCache(impl_->cache->firstYear(), impl_->cache->lastYear());
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no implementation provided");
 
@@ -40,6 +141,8 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(_d))
             impl_->addedHolidays.insert(_d);
+        if (impl_->cache && impl_->cache->covers(_d))
+            impl_->cache->set(_d, false);
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -57,6 +160,8 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(_d))
             impl_->removedHolidays.insert(_d);
+        if (impl_->cache && impl_->cache->covers(_d))
+            impl_->cache->set(_d, true);
     }
 
     Date Calendar::adjust(const Date& d,
@@ -157,23 +262,21 @@ namespace QuantLib {
                                                     bool includeLast) const {
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
+            const Date& first = std::min(from, to);
+            const Date& last = std::max(from, to);
+            if (impl_ && impl_->cache && impl_->cache->covers(first)
+                                     && impl_->cache->covers(last)) {
+                wd = impl_->cache->count(first, last);
+            } else {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
+                for (Date d = first; d < last; ++d) {
                     if (isBusinessDay(d))
                         ++wd;
                 }
-                if (isBusinessDay(from))
-                    ++wd;
             }
+            if (isBusinessDay(last))
+                ++wd;
 
             if (isBusinessDay(from) && !includeFirst)
                 wd--;
@@ -30,6 +30,7 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <ql/shared_ptr.hpp>
+#include <boost/dynamic_bitset.hpp>
 #include <set>
 #include <vector>
 #include <string>
@@ -52,12 +53,49 @@ namespace QuantLib {
 
         \ingroup datetime
 
+        Optionally, the business days over a range of years can be
+        precomputed and stored in a bitmap together with their running
+        count; see enableCache().  Checking a date within the range
+        then requires no evaluation of the holiday rules, and
+        businessDaysBetween() takes constant time.
+
         \test the methods for adding and removing holidays are tested
               by inspecting the calendar before and after their
               invocation.
     */
     class Calendar {
       protected:
+        //! precomputed business days over a range of dates
+        class BusinessDayCache {
+          public:
+            BusinessDayCache(Year firstYear, Year lastYear,
+                             const boost::dynamic_bitset<>& businessDays);
+            Year firstYear() const { return firstYear_; }
+            Year lastYear() const { return lastYear_; }
+            bool covers(const Date& d) const {
+                return d.serialNumber() >= first_
+                    && d.serialNumber() < first_ + Date::serial_type(
+                                                       businessDays_.size());
+            }
+            bool isBusinessDay(const Date& d) const {
+                return businessDays_[d.serialNumber() - first_];
+            }
+            //! number of business days in [from, to)
+            Date::serial_type count(const Date& from, const Date& to) const {
+                return counts_[to.serialNumber() - first_]
+                    - counts_[from.serialNumber() - first_];
+            }
+            void set(const Date& d, bool isBusinessDay);
+            //! business days from the given date on
+            boost::dynamic_bitset<> businessDays(const Date& from,
+                                                 Size n) const;
+          private:
+            Year firstYear_, lastYear_;
+            Date::serial_type first_;
+            boost::dynamic_bitset<> businessDays_;
+            // counts_[i] is the number of business days before first_+i
+            std::vector<Date::serial_type> counts_;
+        };
         //! abstract base class for calendar implementations
         class Impl {
           public:
@@ -65,9 +103,23 @@ namespace QuantLib {
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
+            //! business days, not accounting for added or removed holidays
+            /*! Bit i of the result is set iff <tt>from+i</tt> is a
+                business day.  Derived classes can override this
+                method when a faster way to obtain the whole range is
+                available.
+            */
+            virtual boost::dynamic_bitset<> businessDays(const Date& from,
+                                                         Size n) const;
             std::set<Date> addedHolidays, removedHolidays;
+            ext::shared_ptr<BusinessDayCache> cache;
         };
         ext::shared_ptr<Impl> impl_;
+        //! recomputes the cached business days, if any
+        /*! Derived calendars must call this method when the rules
+            of their implementation change.
+        */
+        void refreshCache();
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -143,6 +195,34 @@ namespace QuantLib {
                                               const Date& to,
                                               bool includeFirst = true,
                                               bool includeLast = false) const;
+        /*! Returns the business days from the given date to the
+            given date (both included); bit i of the result is set
+            iff <tt>from+i</tt> is a business day.
+        */
+        boost::dynamic_bitset<> businessDays(const Date& from,
+                                             const Date& to) const;
+        //@}
+
+        //! \name Business-day cache
+        //@{
+        /*! Precomputes the business days between the start of the
+            first year and the end of the last year.  Dates outside
+            this range are still checked against the holiday rules.
+
+            The cache is updated when holidays are added or removed.
+            As for those, it is shared by all instances of the
+            calendar that share the same implementation.
+
+            \warning the business days of a JointCalendar are
+                     computed from those of its underlying calendars
+                     when the cache is enabled; holidays added to or
+                     removed from the underlying calendars afterwards
+                     are not reflected until the cache is enabled
+                     again.
+        */
+        void enableCache(Year firstYear = 1970, Year lastYear = 2100);
+        void disableCache();
+        bool cacheEnabled() const;
         //@}
 
       protected:
@@ -203,6 +283,9 @@ namespace QuantLib {
         const Date& _d = d;
 #endif
 
+        if (impl_->cache && impl_->cache->covers(_d))
+            return impl_->cache->isBusinessDay(_d);
+
         if (impl_->addedHolidays.find(_d) != impl_->addedHolidays.end())
             return false;
         if (impl_->removedHolidays.find(_d) != impl_->removedHolidays.end())
@@ -211,6 +294,11 @@ namespace QuantLib {
         return impl_->isBusinessDay(_d);
     }
 
+    inline bool Calendar::cacheEnabled() const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        return bool(impl_->cache);
+    }
+
     inline bool Calendar::isEndOfMonth(const Date& d) const {
         return (d.month() != adjust(d+1).month());
     }
@@ -114,6 +114,27 @@ namespace QuantLib {
         }
     }
 
+    boost::dynamic_bitset<>
+    JointCalendar::Impl::businessDays(const Date& from, Size n) const {
+        QL_REQUIRE(n > 0, "empty date range");
+        const Date to = from + Date::serial_type(n-1);
+        boost::dynamic_bitset<> result =
+            calendars_.front().businessDays(from, to);
+        std::vector<Calendar>::const_iterator i;
+        switch (rule_) {
+          case JoinHolidays:
+            for (i=calendars_.begin()+1; i!=calendars_.end(); ++i)
+                result &= i->businessDays(from, to);
+            return result;
+          case JoinBusinessDays:
+            for (i=calendars_.begin()+1; i!=calendars_.end(); ++i)
+                result |= i->businessDays(from, to);
+            return result;
+          default:
+            QL_FAIL("unknown joint calendar rule");
+        }
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
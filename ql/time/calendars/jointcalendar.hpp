@@ -46,6 +46,12 @@ namespace QuantLib {
         business days given by either the union or the intersection
         of the sets of business days of the given calendars.
 
+        When the business-day cache is enabled, the business days of
+        the joint calendar are obtained by combining the ones of the
+        given calendars with bitwise operations; the latter are
+        themselves taken from the caches of the given calendars when
+        enabled.
+
         \ingroup calendars
 
         \test the correctness of the returned results is tested by
@@ -65,6 +71,7 @@ namespace QuantLib {
             std::string name() const;
             bool isWeekend(Weekday) const;
             bool isBusinessDay(const Date&) const;
+            boost::dynamic_bitset<> businessDays(const Date&, Size) const;
           private:
             JointCalendarRule rule_;
             std::vector<Calendar> calendars_;
@@ -28,6 +28,7 @@
 #include <ql/pricingengines/vanilla/juquadraticengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fdshoutengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -569,6 +570,82 @@ void AmericanOptionTest::testFdShoutGreeks() {
     testFdGreeks<FDShoutEngine<CrankNicolson> >();
 }
 
+void AmericanOptionTest::testFdAdaptiveTimeStepping() {
+    BOOST_TEST_MESSAGE("Testing finite-differences engine with adaptive "
+                       "time stepping and Richardson extrapolation...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual360();
+    const Date today = Date(24, April, 2019);
+    Settings::instance().evaluationDate() = today;
+
+    const ext::shared_ptr<BlackScholesMertonProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+
+    const ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0);
+    const Date maturity = today + Period(1, Years);
+
+    const Size xGrid = 200;
+
+    // American option, adaptive steps against a fine fixed grid
+    VanillaOption americanOption(
+        payoff, ext::make_shared<AmericanExercise>(today, maturity));
+
+    americanOption.setPricingEngine(
+        ext::make_shared<FdBlackScholesVanillaEngine>(
+            process, 2000, xGrid, 0, FdmSchemeDesc::Douglas()));
+    const Real expected = americanOption.NPV();
+
+    americanOption.setPricingEngine(
+        ext::make_shared<FdBlackScholesVanillaEngine>(
+            process, 1, xGrid, 0, FdmSchemeDesc::Adaptive(1e-5)));
+    const Real adaptive = americanOption.NPV();
+
+    const Real tolerance = 2e-3;
+    if (std::fabs(adaptive - expected) > tolerance) {
+        BOOST_ERROR("failed to reproduce American option value "
+                    "with adaptive time stepping"
+                    << "\n    calculated: " << adaptive
+                    << "\n    expected:   " << expected
+                    << "\n    tolerance:  " << tolerance);
+    }
+
+    // European option, Richardson extrapolation on a coarse grid
+    VanillaOption europeanOption(
+        payoff, ext::make_shared<EuropeanExercise>(maturity));
+
+    europeanOption.setPricingEngine(
+        ext::make_shared<FdBlackScholesVanillaEngine>(
+            process, 2000, xGrid, 0, FdmSchemeDesc::Douglas()));
+    const Real reference = europeanOption.NPV();
+
+    const Size tGrid = 50, dampingSteps = 2;
+    europeanOption.setPricingEngine(
+        ext::make_shared<FdBlackScholesVanillaEngine>(
+            process, tGrid, xGrid, dampingSteps, FdmSchemeDesc::Douglas()));
+    const Real douglasError = std::fabs(europeanOption.NPV() - reference);
+
+    europeanOption.setPricingEngine(
+        ext::make_shared<FdBlackScholesVanillaEngine>(
+            process, tGrid, xGrid, dampingSteps,
+            FdmSchemeDesc::Richardson()));
+    const Real richardsonError = std::fabs(europeanOption.NPV() - reference);
+
+    if (richardsonError > douglasError || richardsonError > tolerance) {
+        BOOST_ERROR("Richardson extrapolation does not improve "
+                    "the Douglas scheme"
+                    << "\n    Douglas error:    " << douglasError
+                    << "\n    Richardson error: " << richardsonError
+                    << "\n    tolerance:        " << tolerance);
+    }
+}
+
 test_suite* AmericanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("American option tests");
     suite->add(
@@ -583,6 +660,8 @@ test_suite* AmericanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAmericanGreeks));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdShoutGreeks));
+    suite->add(
+        QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAdaptiveTimeStepping));
     return suite;
 }
 
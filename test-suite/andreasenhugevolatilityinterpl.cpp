@@ -915,6 +915,59 @@ void AndreasenHugeVolatilityInterplTest::testDifferentOptimizers() {
     }
 }
 
+void AndreasenHugeVolatilityInterplTest::testAnalyticJacobian() {
+    BOOST_TEST_MESSAGE(
+        "Testing Andreasen-Huge calibration with analytic Jacobian "
+        "and warm start...");
+
+    const CalibrationData& data = sabrData().first;
+
+    const ext::shared_ptr<AndreasenHugeVolatilityInterpl> finiteDiff(
+        ext::make_shared<AndreasenHugeVolatilityInterpl>(
+            data.calibrationSet, data.spot, data.rTS, data.qTS,
+            AndreasenHugeVolatilityInterpl::CubicSpline,
+            AndreasenHugeVolatilityInterpl::Call,
+            400, Null<Real>(), Null<Real>(),
+            ext::make_shared<LevenbergMarquardt>()));
+
+    const ext::shared_ptr<AndreasenHugeVolatilityInterpl> analytic(
+        ext::make_shared<AndreasenHugeVolatilityInterpl>(
+            data.calibrationSet, data.spot, data.rTS, data.qTS,
+            AndreasenHugeVolatilityInterpl::CubicSpline,
+            AndreasenHugeVolatilityInterpl::Call,
+            400, Null<Real>(), Null<Real>(),
+            ext::make_shared<LevenbergMarquardt>(1e-8, 1e-8, 1e-8, true)));
+
+    const Real tol = 0.0001;
+    const Real avgErrorFd = finiteDiff->calibrationError().get<2>();
+    const Real avgError = analytic->calibrationError().get<2>();
+
+    if (boost::math::isnan(avgError) || avgError > tol)
+        BOOST_FAIL("failed to calibrate Andreasen-Huge volatility "
+                   "interpolation with analytic Jacobian"
+                   << "\n    calibration error:              " << avgError
+                   << "\n    finite-difference Jacobian error: " << avgErrorFd
+                   << "\n    tolerance:                      " << tol);
+
+    // recalibration after a small market move starts from the
+    // previous solution
+    const ext::shared_ptr<SimpleQuote> quote =
+        ext::dynamic_pointer_cast<SimpleQuote>(
+            data.calibrationSet.front().second);
+    QL_REQUIRE(quote, "simple quote expected");
+    const Real vol = quote->value();
+    quote->setValue(vol + 0.001);
+
+    const Real avgErrorBumped = analytic->calibrationError().get<2>();
+    quote->setValue(vol);
+
+    if (boost::math::isnan(avgErrorBumped) || avgErrorBumped > tol)
+        BOOST_FAIL("failed to recalibrate Andreasen-Huge volatility "
+                   "interpolation after a market move"
+                   << "\n    calibration error: " << avgErrorBumped
+                   << "\n    tolerance:         " << tol);
+}
+
 void AndreasenHugeVolatilityInterplTest::testMovingReferenceDate() {
     BOOST_TEST_MESSAGE(
         "Testing that reference date of adapter surface moves along with "
@@ -1004,6 +1057,8 @@ test_suite* AndreasenHugeVolatilityInterplTest::suite(SpeedLevel speed) {
         &AndreasenHugeVolatilityInterplTest::testPeterAndFabiensExample));
     suite->add(QUANTLIB_TEST_CASE(
         &AndreasenHugeVolatilityInterplTest::testDifferentOptimizers));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AndreasenHugeVolatilityInterplTest::testAnalyticJacobian));
     suite->add(QUANTLIB_TEST_CASE(
         &AndreasenHugeVolatilityInterplTest::testMovingReferenceDate));
 
@@ -25,6 +25,7 @@
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swaption/fdhullwhiteswaptionengine.hpp>
 #include <ql/pricingengines/swaption/fdg2swaptionengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/cashflows/coupon.hpp>
@@ -297,10 +298,188 @@ void BermudanSwaptionTest::testCachedG2Values() {
     }
 }
 
+void BermudanSwaptionTest::testBranchingCache() {
+    BOOST_TEST_MESSAGE(
+        "Testing Bermudan swaption rollback with cached tree branching...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+    Settings::instance().evaluationDate() = vars.today;
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                       0.04875825,
+                                       Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+    ext::shared_ptr<VanillaSwap> swap = vars.makeSwap(atmRate);
+
+    std::vector<Date> exerciseDates;
+    const Leg& leg = swap->fixedLeg();
+    for (Size i=0; i<leg.size(); i++) {
+        ext::shared_ptr<Coupon> coupon =
+            ext::dynamic_pointer_cast<Coupon>(leg[i]);
+        exerciseDates.push_back(coupon->accrualStartDate());
+    }
+    ext::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+    Swaption swaption(swap, exercise);
+
+    Swaption::arguments arguments;
+    swaption.setupArguments(&arguments);
+    DayCounter dayCounter = vars.termStructure->dayCounter();
+    Date referenceDate = vars.termStructure->referenceDate();
+    Time firstExercise = dayCounter.yearFraction(referenceDate,
+                                                 exerciseDates.front());
+    Time lastExercise = dayCounter.yearFraction(referenceDate,
+                                                exerciseDates.back());
+
+    ext::shared_ptr<ShortRateModel> models[] = {
+        ext::shared_ptr<ShortRateModel>(
+            new HullWhite(vars.termStructure, 0.048696, 0.0058904)),
+        ext::shared_ptr<ShortRateModel>(
+            new G2(vars.termStructure, 0.1, 0.01, 0.1, 0.01, -0.75))
+    };
+    Size steps[] = { 200, 30 };
+
+    for (Size m=0; m<LENGTH(models); ++m) {
+        DiscretizedSwaption discretizedSwaption(arguments, referenceDate,
+                                                dayCounter);
+        std::vector<Time> times = discretizedSwaption.mandatoryTimes();
+        TimeGrid grid(times.begin(), times.end(), steps[m]);
+
+        Real values[3];
+        for (Size k=0; k<3; ++k) {
+            ext::shared_ptr<Lattice> lattice = models[m]->tree(grid);
+            if (k == 0) {
+                if (ext::shared_ptr<OneFactorModel::ShortRateTree> tree =
+                        ext::dynamic_pointer_cast<
+                            OneFactorModel::ShortRateTree>(lattice))
+                    tree->disableBranchingCache();
+                else
+                    ext::dynamic_pointer_cast<
+                        TwoFactorModel::ShortRateTree>(lattice)
+                            ->disableBranchingCache();
+            }
+            // the last value reuses the branching cached by the
+            // previous rollback on the same lattice
+            for (Size r=0; r<(k == 2 ? 2 : 1); ++r) {
+                discretizedSwaption.initialize(lattice, lastExercise);
+                discretizedSwaption.rollback(firstExercise);
+                values[k] = discretizedSwaption.presentValue();
+            }
+        }
+
+        Real tolerance = 1.0e-12;
+        for (Size k=1; k<3; ++k) {
+            if (std::fabs(values[k] - values[0]) > tolerance)
+                BOOST_ERROR("failed to reproduce swaption value "
+                            "without branching cache:"
+                            << std::setprecision(12)
+                            << "\n    model:      " << m
+                            << "\n    calculated: " << values[k]
+                            << "\n    expected:   " << values[0]);
+        }
+    }
+}
+
+void BermudanSwaptionTest::testBatchedRollback() {
+    BOOST_TEST_MESSAGE(
+        "Testing batched rollback of Bermudan swaptions on one lattice...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+    Settings::instance().evaluationDate() = vars.today;
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                       0.04875825,
+                                       Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+    DayCounter dayCounter = vars.termStructure->dayCounter();
+    Date referenceDate = vars.termStructure->referenceDate();
+
+    // swaptions with different strikes and exercise schedules
+    std::vector<ext::shared_ptr<DiscretizedAsset> > swaptions;
+    std::vector<Time> times;
+    Time lastExercise = 0.0;
+    Real moneyness[] = { 0.8, 1.0, 1.2 };
+    for (Size i=0; i<LENGTH(moneyness); ++i) {
+        ext::shared_ptr<VanillaSwap> swap =
+            vars.makeSwap(moneyness[i]*atmRate);
+        for (Size shift=0; shift<2; ++shift) {
+            std::vector<Date> exerciseDates;
+            const Leg& leg = swap->fixedLeg();
+            for (Size j=0; j<leg.size(); j++) {
+                ext::shared_ptr<Coupon> coupon =
+                    ext::dynamic_pointer_cast<Coupon>(leg[j]);
+                exerciseDates.push_back(vars.calendar.adjust(
+                    coupon->accrualStartDate() - Integer(10*shift)));
+            }
+            Swaption swaption(swap, ext::shared_ptr<Exercise>(
+                                   new BermudanExercise(exerciseDates)));
+            Swaption::arguments arguments;
+            swaption.setupArguments(&arguments);
+            swaptions.push_back(ext::shared_ptr<DiscretizedAsset>(
+                new DiscretizedSwaption(arguments, referenceDate,
+                                        dayCounter)));
+            std::vector<Time> t = swaptions.back()->mandatoryTimes();
+            times.insert(times.end(), t.begin(), t.end());
+            lastExercise = std::max(lastExercise,
+                                    dayCounter.yearFraction(
+                                        referenceDate, exerciseDates.back()));
+        }
+    }
+    // roll back to a common time before all exercises
+    Time firstExercise = 0.5;
+    times.push_back(firstExercise);
+
+    ext::shared_ptr<ShortRateModel> models[] = {
+        ext::shared_ptr<ShortRateModel>(
+            new HullWhite(vars.termStructure, 0.048696, 0.0058904)),
+        ext::shared_ptr<ShortRateModel>(
+            new G2(vars.termStructure, 0.1, 0.01, 0.1, 0.01, -0.75))
+    };
+    Size steps[] = { 100, 20 };
+
+    for (Size m=0; m<LENGTH(models); ++m) {
+        TimeGrid grid(times.begin(), times.end(), steps[m]);
+        ext::shared_ptr<Lattice> lattice = models[m]->tree(grid);
+
+        std::vector<Real> expected(swaptions.size());
+        for (Size k=0; k<swaptions.size(); ++k) {
+            swaptions[k]->initialize(lattice, lastExercise);
+            swaptions[k]->rollback(firstExercise);
+            expected[k] = swaptions[k]->presentValue();
+        }
+
+        for (Size k=0; k<swaptions.size(); ++k)
+            swaptions[k]->initialize(lattice, lastExercise);
+        lattice->rollback(swaptions, firstExercise);
+
+        Real tolerance = 1.0e-12;
+        for (Size k=0; k<swaptions.size(); ++k) {
+            Real calculated = swaptions[k]->presentValue();
+            if (std::fabs(calculated - expected[k]) > tolerance)
+                BOOST_ERROR("failed to reproduce swaption value "
+                            "with batched rollback:"
+                            << std::setprecision(12)
+                            << "\n    model:      " << m
+                            << "\n    swaption:   " << k
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected[k]);
+        }
+    }
+}
+
 test_suite* BermudanSwaptionTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Bermudan swaption tests");
 
     suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedValues));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BermudanSwaptionTest::testBranchingCache));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BermudanSwaptionTest::testBatchedRollback));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -30,6 +30,8 @@ class BermudanSwaptionTest {
   public:
     static void testCachedValues();
     static void testCachedG2Values();
+    static void testBranchingCache();
+    static void testBatchedRollback();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -2137,6 +2137,99 @@ void CalendarTest::testIntradayAddHolidays() {
 #endif
 }
 
+void CalendarTest::testBusinessDayCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached business days...");
+
+    Calendar c1 = TARGET(), c2 = UnitedKingdom();
+    Date firstDate(1, January, 2015), endDate(1, January, 2025);
+
+    std::vector<bool> expected1, expected2;
+    for (Date d = firstDate; d < endDate; ++d) {
+        expected1.push_back(c1.isBusinessDay(d));
+        expected2.push_back(c2.isBusinessDay(d));
+    }
+    std::vector<std::pair<Date, Date> > periods;
+    std::vector<Date::serial_type> expectedDays;
+    for (Date d1 = firstDate; d1 < endDate; d1 += 37) {
+        for (Date d2 = d1 - 400; d2 < d1 + 800; d2 += 53) {
+            periods.push_back(std::make_pair(d1, d2));
+            expectedDays.push_back(c1.businessDaysBetween(d1, d2));
+        }
+    }
+
+    c1.enableCache(2016, 2022);
+    c2.enableCache(2016, 2022);
+    Calendar c12h = JointCalendar(c1, c2, JoinHolidays),
+             c12b = JointCalendar(c1, c2, JoinBusinessDays);
+    c12h.enableCache(2015, 2023);
+    c12b.enableCache(2015, 2023);
+
+    if (!c1.cacheEnabled() || !TARGET().cacheEnabled())
+        BOOST_ERROR("cache not enabled");
+
+    Size i = 0;
+    for (Date d = firstDate; d < endDate; ++d, ++i) {
+        bool b1 = expected1[i], b2 = expected2[i];
+        if (c1.isBusinessDay(d) != b1)
+            BOOST_FAIL("wrong cached business day for " << c1.name()
+                       << " at " << d);
+        if (c2.isBusinessDay(d) != b2)
+            BOOST_FAIL("wrong cached business day for " << c2.name()
+                       << " at " << d);
+        if (c12h.isBusinessDay(d) != (b1 && b2))
+            BOOST_FAIL("wrong cached business day for " << c12h.name()
+                       << " at " << d);
+        if (c12b.isBusinessDay(d) != (b1 || b2))
+            BOOST_FAIL("wrong cached business day for " << c12b.name()
+                       << " at " << d);
+    }
+
+    for (i=0; i<periods.size(); ++i) {
+        Date::serial_type calculated =
+            c1.businessDaysBetween(periods[i].first, periods[i].second);
+        if (calculated != expectedDays[i])
+            BOOST_FAIL("wrong number of business days between "
+                       << periods[i].first << " and "
+                       << periods[i].second
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expectedDays[i]);
+    }
+
+    c1.disableCache();
+    c2.disableCache();
+
+    // cache updates
+    BespokeCalendar b("bespoke calendar with cache");
+    b.addWeekend(Saturday);
+    b.addWeekend(Sunday);
+    b.enableCache(2015, 2020);
+
+    Date start(4, January, 2016), end(4, January, 2017),
+         holiday(15, June, 2016);
+    Date::serial_type days = b.businessDaysBetween(start, end);
+
+    b.addHoliday(holiday);
+    if (b.isBusinessDay(holiday))
+        BOOST_ERROR(holiday << " still a business day");
+    if (b.businessDaysBetween(start, end) != days - 1)
+        BOOST_ERROR("wrong number of business days after adding "
+                    << holiday << ": " << b.businessDaysBetween(start, end)
+                    << " instead of " << days - 1);
+
+    b.removeHoliday(holiday);
+    if (!b.isBusinessDay(holiday))
+        BOOST_ERROR(holiday << " still a holiday");
+    if (b.businessDaysBetween(start, end) != days)
+        BOOST_ERROR("wrong number of business days after removing "
+                    << holiday << ": " << b.businessDaysBetween(start, end)
+                    << " instead of " << days);
+
+    b.addWeekend(Friday);
+    if (b.isBusinessDay(Date(17, June, 2016)))
+        BOOST_ERROR("added weekend day not reflected in cache");
+}
+
 test_suite* CalendarTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Calendar tests");
 
@@ -2173,6 +2266,7 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDayCache));
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testIntradayAddHolidays));
 
@@ -60,6 +60,7 @@ class CalendarTest {
 
     static void testEndOfMonth();
     static void testBusinessDaysBetween();
+    static void testBusinessDayCache();
 
     static void testIntradayAddHolidays();
 
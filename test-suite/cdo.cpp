@@ -27,12 +27,16 @@
 #include <ql/experimental/credit/inhomogeneouspooldef.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
+#include <ql/experimental/credit/binomiallossmodel.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/currencies/europe.hpp>
 #include <ql/functional.hpp>
 #include <boost/preprocessor/iteration/local.hpp>
@@ -368,9 +372,251 @@ void CdoTest::testHW(unsigned dataSet) {
 }
 
 
+void CdoTest::testSemiAnalyticalModels() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing recursive and binomial loss models "
+                       "against the conditional binomial distribution...");
+
+    SavedSettings backup;
+
+    Size poolSize = 20;
+    Real lambda = 0.02;
+    Real recovery = 0.4;
+    Real nominal = 100.0;
+    Real lgd = nominal*(1.0-recovery);
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    ext::shared_ptr<DefaultProbabilityTermStructure> ptr(
+        new FlatHazardRate(asofDate,
+                           Handle<Quote>(ext::make_shared<SimpleQuote>(lambda)),
+                           ActualActual()));
+    vector<pair<DefaultProbKey,
+           Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                   Period(0, Weeks), 10.),
+        Handle<DefaultProbabilityTermStructure>(ptr)));
+    ext::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+    vector<Real> nominals(poolSize, nominal);
+
+    ext::shared_ptr<SimpleQuote> correlation(new SimpleQuote(0.3));
+    ext::shared_ptr<GaussianConstantLossLM> lm(new GaussianConstantLossLM(
+        Handle<Quote>(correlation), vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+
+    // the same model instances are shared by all tranches
+    ext::shared_ptr<DefaultLossModel> recursive(
+        new RecursiveLossModel<GaussianCopulaPolicy>(lm));
+    ext::shared_ptr<DefaultLossModel> binomial(
+        new GaussianBinomialLossModel(lm));
+
+    vector<ext::shared_ptr<Basket> > tranches;
+    for (Size j=0; j<LENGTH(hwAttachment); ++j)
+        tranches.push_back(ext::make_shared<Basket>(
+            asofDate, names, nominals, pool,
+            hwAttachment[j], hwDetachment[j]));
+
+    Date dates[] = { asofDate + 1*Years, asofDate + 5*Years };
+    Real correlations[] = { 0.3, 0.5 };
+    GaussHermiteIntegration quadrature(25);
+    CumulativeNormalDistribution cumulative;
+    InverseCumulativeNormal inverse;
+    NormalDistribution density;
+    Real tolerance = 1.0e-10;
+
+    for (Size c=0; c<LENGTH(correlations); ++c) {
+        correlation->setValue(correlations[c]);
+        Real beta = std::sqrt(correlations[c]);
+        // twice, the second pass uses the cached distributions
+        for (Size pass=0; pass<2; ++pass) {
+            for (Size j=0; j<tranches.size(); ++j) {
+                Real attach = hwAttachment[j]*poolSize*nominal;
+                Real detach = hwDetachment[j]*poolSize*nominal;
+                for (Size d=0; d<LENGTH(dates); ++d) {
+                    Real p = inverse(ptr->defaultProbability(dates[d]));
+                    // expected tranche loss and loss distribution of the
+                    // homogeneous pool, with the model quadrature
+                    Real expected = 0.0;
+                    vector<Real> distribution(poolSize+1, 0.0);
+                    for (Size i=0; i<quadrature.order(); ++i) {
+                        Real m = quadrature.x()[i];
+                        Real w = quadrature.weights()[i]*density(m);
+                        Real q = cumulative((p - beta*m)
+                                            / std::sqrt(1.0-beta*beta));
+                        Real binomialCoeff = 1.0;
+                        for (Size k=0; k<=poolSize; ++k) {
+                            Real pk = binomialCoeff*std::pow(q, Real(k))
+                                * std::pow(1.0-q, Real(poolSize-k));
+                            Real loss = std::min(std::max(k*lgd - attach, 0.0),
+                                                 detach - attach);
+                            expected += w*pk*loss;
+                            distribution[k] += w*pk;
+                            binomialCoeff *= Real(poolSize-k)/(k+1);
+                        }
+                    }
+
+                    tranches[j]->setLossModel(recursive);
+                    Real calculated = tranches[j]->expectedTrancheLoss(dates[d]);
+                    if (std::fabs(calculated - expected) > tolerance*detach)
+                        BOOST_ERROR("failed to reproduce expected tranche loss"
+                                    " with recursive model"
+                                    << "\n    tranche:    " << j
+                                    << "\n    date:       " << dates[d]
+                                    << "\n    correlation: "
+                                    << correlations[c]
+                                    << std::setprecision(12)
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected);
+                    std::map<Real, Probability> distrib =
+                        tranches[j]->lossDistribution(dates[d]);
+                    Real cumulated = 0.0;
+                    for (Size k=0; k<=poolSize; ++k) {
+                        cumulated += distribution[k];
+                        Real found = distrib[k*lgd];
+                        if (std::fabs(found - cumulated) > tolerance)
+                            BOOST_ERROR("failed to reproduce loss "
+                                        "distribution with recursive model"
+                                        << "\n    tranche:    " << j
+                                        << "\n    date:       " << dates[d]
+                                        << "\n    loss:       " << k*lgd
+                                        << std::setprecision(12)
+                                        << "\n    calculated: " << found
+                                        << "\n    expected:   "
+                                        << cumulated);
+                    }
+
+                    tranches[j]->setLossModel(binomial);
+                    calculated = tranches[j]->expectedTrancheLoss(dates[d]);
+                    if (std::fabs(calculated - expected) > tolerance*detach)
+                        BOOST_ERROR("failed to reproduce expected tranche loss"
+                                    " with binomial model"
+                                    << "\n    tranche:    " << j
+                                    << "\n    date:       " << dates[d]
+                                    << "\n    correlation: "
+                                    << correlations[c]
+                                    << std::setprecision(12)
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected);
+                }
+            }
+        }
+    }
+    #endif
+}
+
+
+void CdoTest::testRandomDefaultModel() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing random default model "
+                       "against the recursive loss model...");
+
+    SavedSettings backup;
+
+    Size poolSize = 20;
+    Real lambda = 0.02;
+    Real recovery = 0.4;
+    Real nominal = 100.0;
+    // more than one block of samples
+    Size numSims = 10000;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    ext::shared_ptr<DefaultProbabilityTermStructure> ptr(
+        new FlatHazardRate(asofDate,
+                           Handle<Quote>(ext::make_shared<SimpleQuote>(lambda)),
+                           ActualActual()));
+    vector<pair<DefaultProbKey,
+           Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                   Period(0, Weeks), 10.),
+        Handle<DefaultProbabilityTermStructure>(ptr)));
+    ext::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+    vector<Real> nominals(poolSize, nominal);
+
+    ext::shared_ptr<SimpleQuote> correlation(new SimpleQuote(0.3));
+    ext::shared_ptr<GaussianConstantLossLM> lm(new GaussianConstantLossLM(
+        Handle<Quote>(correlation), vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+
+    ext::shared_ptr<DefaultLossModel> recursive(
+        new RecursiveLossModel<GaussianCopulaPolicy>(lm));
+    ext::shared_ptr<DefaultLossModel> random(
+        new RandomDefaultLM<GaussianCopulaPolicy>(lm, numSims));
+
+    Date dates[] = { asofDate + 1*Years, asofDate + 5*Years };
+
+    for (Size j=0; j<LENGTH(hwAttachment); ++j) {
+        ext::shared_ptr<Basket> tranche = ext::make_shared<Basket>(
+            asofDate, names, nominals, pool,
+            hwAttachment[j], hwDetachment[j]);
+        Real detach = hwDetachment[j]*poolSize*nominal;
+        for (Size d=0; d<LENGTH(dates); ++d) {
+            tranche->setLossModel(recursive);
+            Real expected = tranche->expectedTrancheLoss(dates[d]);
+
+            tranche->setLossModel(random);
+            Real calculated = tranche->expectedTrancheLoss(dates[d]);
+            // Monte Carlo tolerance
+            Real error = 0.05*expected + 1.0e-3*detach;
+            if (std::fabs(calculated - expected) > error)
+                BOOST_ERROR("failed to reproduce expected tranche loss"
+                            << "\n    tranche:    " << j
+                            << "\n    date:       " << dates[d]
+                            << std::setprecision(8)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected
+                            << "\n    tolerance:  " << error);
+
+            // the simulation is repeated after the model changes...
+            correlation->setValue(0.5);
+            tranche->expectedTrancheLoss(dates[d]);
+            correlation->setValue(0.3);
+            // ...and reproduces the same samples
+            Real repeated = tranche->expectedTrancheLoss(dates[d]);
+            if (repeated != calculated)
+                BOOST_ERROR("failed to reproduce simulated tranche loss"
+                            << "\n    tranche:    " << j
+                            << "\n    date:       " << dates[d]
+                            << std::setprecision(12)
+                            << "\n    first:      " << calculated
+                            << "\n    repeated:   " << repeated);
+        }
+    }
+    #endif
+}
+
+
 test_suite* CdoTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     #ifndef QL_PATCH_SOLARIS
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testSemiAnalyticalModels));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testRandomDefaultModel));
     if (speed == Slow) {
         #define BOOST_PP_LOCAL_MACRO(n) \
             suite->add(QUANTLIB_TEST_CASE(ext::bind(&CdoTest::testHW, n)));
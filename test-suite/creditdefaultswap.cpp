@@ -712,6 +712,88 @@ void CreditDefaultSwapTest::testIsdaEngine() {
 
 }
 
+void CreditDefaultSwapTest::testIsdaEngineCache() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing cached integration schedule of the ISDA engine...");
+
+    SavedSettings backup;
+
+    Date tradeDate(21, May, 2009);
+    Settings::instance().evaluationDate() = tradeDate;
+
+    Date discountDates[] = { tradeDate, Date(21, May, 2010),
+                             Date(21, May, 2012), Date(21, May, 2015),
+                             Date(21, May, 2020) };
+    DiscountFactor discounts[] = { 1.0, 0.985, 0.94, 0.86, 0.72 };
+    DiscountFactor otherDiscounts[] = { 1.0, 0.99, 0.95, 0.88, 0.75 };
+    Date hazardDates[] = { tradeDate, Date(20, June, 2010),
+                           Date(20, June, 2012), Date(20, June, 2014),
+                           Date(20, June, 2016) };
+    Real hazardRates[] = { 0.01, 0.01, 0.015, 0.02, 0.025 };
+    // only the last pillar differs, as in a bootstrap
+    Real otherHazardRates[] = { 0.01, 0.01, 0.015, 0.02, 0.04 };
+    Date otherHazardDates[] = { tradeDate, Date(20, June, 2011),
+                                Date(20, June, 2013), Date(20, June, 2015),
+                                Date(20, June, 2016) };
+
+    RelinkableHandle<YieldTermStructure> discountCurve;
+    RelinkableHandle<DefaultProbabilityTermStructure> probabilityCurve;
+
+    ext::shared_ptr<IsdaCdsEngine> engine = ext::make_shared<IsdaCdsEngine>(
+        probabilityCurve, 0.4, discountCurve);
+    ext::shared_ptr<CreditDefaultSwap> trade =
+        MakeCreditDefaultSwap(Date(20, June, 2016), 0.01)
+        .withNominal(10000000.)
+        .withPricingEngine(engine);
+
+    Real tolerance = 1.0e-8;
+
+    for (Size i = 0; i < 3; i++) {
+        const DiscountFactor* dfs = i == 2 ? otherDiscounts : discounts;
+        discountCurve.linkTo(ext::make_shared<DiscountCurve>(
+            std::vector<Date>(discountDates, discountDates + 5),
+            std::vector<DiscountFactor>(dfs, dfs + 5), Actual365Fixed()));
+        for (Size j = 0; j < 3; j++) {
+            const Date* dates = j == 2 ? otherHazardDates : hazardDates;
+            const Real* rates = j == 1 ? otherHazardRates : hazardRates;
+            probabilityCurve.linkTo(
+                ext::make_shared<InterpolatedHazardRateCurve<BackwardFlat> >(
+                    std::vector<Date>(dates, dates + 5),
+                    std::vector<Real>(rates, rates + 5), Actual365Fixed()));
+
+            Real cachedNpv = trade->NPV();
+            Real cachedFairSpread = trade->fairSpread();
+            Real cachedFairUpfront = trade->fairUpfront();
+
+            // a new engine starts from an empty cache
+            trade->setPricingEngine(ext::make_shared<IsdaCdsEngine>(
+                probabilityCurve, 0.4, discountCurve));
+            Real npv = trade->NPV();
+            Real fairSpread = trade->fairSpread();
+            Real fairUpfront = trade->fairUpfront();
+            trade->setPricingEngine(engine);
+
+            if (std::fabs(cachedNpv - npv) > tolerance
+                || std::fabs(cachedFairSpread - fairSpread) > tolerance
+                || std::fabs(cachedFairUpfront - fairUpfront) > tolerance)
+                BOOST_ERROR("failed to reproduce CDS results with cached "
+                            "integration schedule"
+                            << std::setprecision(12)
+                            << "\n    discount curve:       " << i
+                            << "\n    default curve:        " << j
+                            << "\n    NPV:                  " << cachedNpv
+                            << "\n    expected:             " << npv
+                            << "\n    fair spread:          "
+                            << cachedFairSpread
+                            << "\n    expected:             " << fairSpread
+                            << "\n    fair upfront:         "
+                            << cachedFairUpfront
+                            << "\n    expected:             " << fairUpfront);
+        }
+    }
+}
+
 test_suite* CreditDefaultSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Credit-default swap tests");
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testCachedValue));
@@ -722,5 +804,6 @@ test_suite* CreditDefaultSwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairUpfront));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testIsdaEngine));
+    suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testIsdaEngineCache));
     return suite;
 }
@@ -1750,6 +1750,93 @@ void EuropeanOptionTest::testFdEngineWithNonConstantParameters() {
     }
 }
 
+void EuropeanOptionTest::testFdEngineSpotShiftCaching() {
+    BOOST_TEST_MESSAGE("Testing finite-difference European engine "
+                       "with spot-shift caching...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    ext::shared_ptr<BlackScholesMertonProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc)));
+
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(today + 360);
+    ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0);
+
+    EuropeanOption cachedOption(payoff, exercise);
+    const ext::shared_ptr<FdBlackScholesVanillaEngine> cachingEngine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, 100, 400);
+    cachingEngine->enableSpotShiftCaching(0.05);
+    cachedOption.setPricingEngine(cachingEngine);
+
+    EuropeanOption option(payoff, exercise);
+    option.setPricingEngine(
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, 100, 400));
+
+    EuropeanOption analyticOption(payoff, exercise);
+    analyticOption.setPricingEngine(
+        ext::make_shared<AnalyticEuropeanEngine>(process));
+
+    // the first calculation solves the PDE
+    if (cachedOption.NPV() != option.NPV()) {
+        BOOST_ERROR("first calculation with caching engine differs from "
+                    "the one without caching"
+                    << "\n    with caching:    " << cachedOption.NPV()
+                    << "\n    without caching: " << option.NPV());
+    }
+
+    // small spot shifts are interpolated on the cached solution
+    const Real tolerance = 5e-3;
+    const Real spots[] = { 100.5, 98.0, 103.0, 100.0 };
+    for (Size i=0; i < LENGTH(spots); ++i) {
+        spot->setValue(spots[i]);
+
+        if (std::fabs(cachedOption.NPV() - analyticOption.NPV()) > tolerance
+            || std::fabs(cachedOption.delta() - analyticOption.delta())
+                > tolerance) {
+            BOOST_ERROR("failed to reproduce analytic results "
+                        "with cached solution"
+                        << "\n    spot:       " << spots[i]
+                        << "\n    npv:        " << cachedOption.NPV()
+                        << "\n    expected:   " << analyticOption.NPV()
+                        << "\n    delta:      " << cachedOption.delta()
+                        << "\n    expected:   " << analyticOption.delta());
+        }
+    }
+    if (cachedOption.NPV() != option.NPV()) {
+        BOOST_ERROR("cached solution not reproduced at initial spot"
+                    << "\n    with caching:    " << cachedOption.NPV()
+                    << "\n    without caching: " << option.NPV());
+    }
+
+    // a different volatility requires a new solution ...
+    vol->setValue(0.3);
+    spot->setValue(101.0);
+    if (cachedOption.NPV() != option.NPV()) {
+        BOOST_ERROR("cached solution used after volatility change"
+                    << "\n    with caching:    " << cachedOption.NPV()
+                    << "\n    without caching: " << option.NPV());
+    }
+
+    // ... and so does a spot outside the tolerance band
+    spot->setValue(110.0);
+    if (cachedOption.NPV() != option.NPV()) {
+        BOOST_ERROR("cached solution used outside the tolerance band"
+                    << "\n    with caching:    " << cachedOption.NPV()
+                    << "\n    without caching: " << option.NPV());
+    }
+}
+
 
 
 test_suite* EuropeanOptionTest::suite() {
@@ -1783,6 +1870,8 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPDESchemes));
     suite->add(QUANTLIB_TEST_CASE(
                  &EuropeanOptionTest::testFdEngineWithNonConstantParameters));
+    suite->add(QUANTLIB_TEST_CASE(
+                 &EuropeanOptionTest::testFdEngineSpotShiftCaching));
     return suite;
 }
 
@@ -50,6 +50,7 @@ class EuropeanOptionTest {
     static void testAnalyticEngineDiscountCurve();
     static void testPDESchemes();
     static void testFdEngineWithNonConstantParameters();
+    static void testFdEngineSpotShiftCaching();
 
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
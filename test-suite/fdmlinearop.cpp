@@ -220,6 +220,70 @@ void FdmLinearOpTest::testFdmLinearOpLayout() {
     }
 }
 
+void FdmLinearOpTest::testFdmLinearOpLayoutNeighbourTables() {
+
+    BOOST_TEST_MESSAGE("Testing neighbour tables of a linear operator "
+                       "layout...");
+
+    Size dims[] = {5,7,4};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    const FdmLinearOpLayout layout(dim);
+
+    for (Size d=0; d < dim.size(); ++d) {
+        const boost::shared_array<Size> lower = layout.neighbours(d, -1);
+        const boost::shared_array<Size> upper = layout.neighbours(d, 1);
+
+        if (layout.neighbours(d, -1) != lower) {
+            BOOST_FAIL("neighbour table in direction " << d
+                       << " is not shared");
+        }
+
+        const FdmLinearOpIterator endIter = layout.end();
+        for (FdmLinearOpIterator iter = layout.begin(); iter != endIter;
+             ++iter) {
+            const Size i = iter.index();
+            if (lower[i] != layout.neighbourhood(iter, d, -1)
+                || upper[i] != layout.neighbourhood(iter, d, 1)) {
+                BOOST_FAIL("wrong neighbours of node " << i
+                           << " in direction " << d
+                           << "\n    lower:    " << lower[i]
+                           << "\n    expected: "
+                           << layout.neighbourhood(iter, d, -1)
+                           << "\n    upper:    " << upper[i]
+                           << "\n    expected: "
+                           << layout.neighbourhood(iter, d, 1));
+            }
+        }
+
+        const boost::shared_array<Size> lines = layout.lines(d);
+        std::vector<bool> visited(layout.size(), false);
+        for (Size l=0; l < layout.size()/dim[d]; ++l) {
+            for (Size k=0; k < dim[d]; ++k) {
+                const Size i = lines[l*dim[d]+k];
+                const Size first = lines[l*dim[d]];
+                for (Size n=0; n < dim.size(); ++n) {
+                    const Size s = layout.spacing()[n];
+                    const Size coord = (i/s)%dim[n];
+                    const Size expected = (n == d) ? k : (first/s)%dim[n];
+                    if (coord != expected) {
+                        BOOST_FAIL("node " << i << " is at position " << k
+                                   << " of line " << l
+                                   << " in direction " << d
+                                   << " but has coordinate " << coord
+                                   << " in direction " << n);
+                    }
+                }
+                if (visited[i]) {
+                    BOOST_FAIL("node " << i << " visited twice on the "
+                               "lines in direction " << d);
+                }
+                visited[i] = true;
+            }
+        }
+    }
+}
+
 void FdmLinearOpTest::testUniformGridMesher() {
 
     BOOST_TEST_MESSAGE("Testing uniform grid mesher...");
@@ -759,6 +823,61 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
 }
 
 
+void FdmLinearOpTest::testTripleBandMapFactorization() {
+
+    BOOST_TEST_MESSAGE("Testing factorised triple-band map solution...");
+
+    Size dims[] = {50, 80};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(-1.0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.0, 2.0));
+
+    ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const Real a = -0.01, b = 1.0;
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        TripleBandLinearOp map(direction, mesher);
+        map.axpyb(Array(1, 0.03), FirstDerivativeOp(direction, mesher),
+                  SecondDerivativeOp(direction, mesher).mult(
+                      0.02*(mesher->locations(1)+1.0)),
+                  Array(1, -0.05));
+
+        const Array expected = map.solve_splitting(u, a, b);
+
+        map.factorize(a, b);
+        if (!map.isFactorized(a, b) || map.isFactorized(a, 2*b))
+            BOOST_FAIL("factorisation not stored for the given factors");
+
+        const Array calculated = map.solve_splitting(u, a, b);
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(expected[i] - calculated[i]) > 1e-12) {
+                BOOST_FAIL("factorised and direct solutions differ "
+                           << "\n direction     : " << direction
+                           << "\n expected      : " << expected[i]
+                           << "\n calculated    : " << calculated[i]);
+            }
+        }
+
+        // the factorisation is neither copied nor kept after axpyb
+        const TripleBandLinearOp copy(map);
+        if (copy.isFactorized(a, b))
+            BOOST_FAIL("factorisation copied together with the map");
+
+        map.axpyb(Array(), map, map, Array(1, 0.5));
+        if (map.isFactorized(a, b))
+            BOOST_FAIL("factorisation kept after modification of the map");
+    }
+}
+
 void FdmLinearOpTest::testFdmHestonBarrier() {
 
     BOOST_TEST_MESSAGE("Testing FDM with barrier option in Heston model...");
@@ -1757,6 +1876,8 @@ test_suite* FdmLinearOpTest::suite() {
 
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmLinearOpLayout));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testFdmLinearOpLayoutNeighbourTables));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testUniformGridMesher));
     suite->add(
@@ -1769,6 +1890,8 @@ test_suite* FdmLinearOpTest::suite() {
         &FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testTripleBandMapFactorization));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
@@ -30,12 +30,14 @@
 class FdmLinearOpTest {
 public:
     static void testFdmLinearOpLayout();
+    static void testFdmLinearOpLayoutNeighbourTables();
     static void testUniformGridMesher();
     static void testFirstDerivativesMapApply();
     static void testSecondDerivativesMapApply();
     static void testDerivativeWeightsOnNonUniformGrids();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testTripleBandMapFactorization();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
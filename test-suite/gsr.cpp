@@ -26,6 +26,8 @@
 #include <ql/pricingengines/swaption/gaussian1dswaptionengine.hpp>
 #include <ql/pricingengines/swaption/gaussian1djamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swaption/gaussian1dnonstandardswaptionengine.hpp>
+#include <ql/pricingengines/swaption/gaussian1dfloatfloatswaptionengine.hpp>
+#include <ql/instruments/floatfloatswaption.hpp>
 #include <ql/indexes/swap/euriborswap.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -285,9 +287,118 @@ void GsrTest::testGsrModel() {
                     << GsrJamNpv << ")");
 }
 
+void GsrTest::testStateGridCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached state grids of the GSR model...");
+
+    SavedSettings backup;
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    Handle<YieldTermStructure> yts(ext::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    Handle<YieldTermStructure> discountCurve(
+        ext::shared_ptr<YieldTermStructure>(
+            new FlatForward(0, TARGET(), 0.025, Actual365Fixed())));
+
+    std::vector<Date> stepDates;
+    for (Size i = 1; i < 10; i++)
+        stepDates.push_back(refDate + i * Years);
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.01));
+    std::vector<Handle<Quote> > vols(stepDates.size() + 1, Handle<Quote>(vol));
+    Handle<Quote> reversion(
+        ext::shared_ptr<Quote>(new SimpleQuote(0.02)));
+
+    // two identical models, one of them without grid cache
+    ext::shared_ptr<Gsr> cached(
+        new Gsr(yts, stepDates, vols, reversion, 50.0));
+    ext::shared_ptr<Gsr> uncached(
+        new Gsr(yts, stepDates, vols, reversion, 50.0));
+    uncached->enableStateGridCache(false);
+
+    ext::shared_ptr<IborIndex> euribor6m(new Euribor6M(yts));
+    ext::shared_ptr<IborIndex> euribor3m(new Euribor3M(yts));
+    Date start = TARGET().advance(refDate, 1 * Years);
+    ext::shared_ptr<VanillaSwap> underlying =
+        MakeVanillaSwap(10 * Years, euribor6m, 0.03)
+            .withEffectiveDate(start);
+    std::vector<Date> exerciseDates;
+    for (Size i = 0; i < underlying->fixedSchedule().size() - 1; i++)
+        exerciseDates.push_back(TARGET().advance(
+            underlying->fixedSchedule().date(i), -2 * Days));
+    ext::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+
+    Schedule schedule1(start, start + 10 * Years, 6 * Months, TARGET(),
+                       ModifiedFollowing, ModifiedFollowing,
+                       DateGeneration::Forward, false);
+    Schedule schedule2(start, start + 10 * Years, 3 * Months, TARGET(),
+                       ModifiedFollowing, ModifiedFollowing,
+                       DateGeneration::Forward, false);
+    ext::shared_ptr<FloatFloatSwap> floatFloatSwap(new FloatFloatSwap(
+        VanillaSwap::Payer, 1.0, 1.0, schedule1, euribor6m, Actual360(),
+        schedule2, euribor3m, Actual360(), false, false, 1.0, 0.0,
+        Null<Real>(), Null<Real>(), 1.0, 0.001));
+
+    std::vector<ext::shared_ptr<Instrument> > instruments;
+    for (Size j = 0; j < 2; j++) {
+        ext::shared_ptr<Gsr> model = j == 0 ? cached : uncached;
+        for (Size i = 0; i < 2; i++) {
+            Handle<YieldTermStructure> curve =
+                i == 0 ? Handle<YieldTermStructure>() : discountCurve;
+            ext::shared_ptr<Swaption> swaption(
+                new Swaption(underlying, exercise));
+            swaption->setPricingEngine(ext::shared_ptr<PricingEngine>(
+                new Gaussian1dSwaptionEngine(model, 64, 7.0, true, false,
+                                             curve)));
+            ext::shared_ptr<NonstandardSwaption> nonstandardSwaption(
+                new NonstandardSwaption(*swaption));
+            nonstandardSwaption->setPricingEngine(
+                ext::shared_ptr<PricingEngine>(
+                    new Gaussian1dNonstandardSwaptionEngine(
+                        model, 64, 7.0, true, false, Handle<Quote>(),
+                        curve)));
+            ext::shared_ptr<FloatFloatSwaption> floatFloatSwaption(
+                new FloatFloatSwaption(floatFloatSwap, exercise));
+            floatFloatSwaption->setPricingEngine(
+                ext::shared_ptr<PricingEngine>(
+                    new Gaussian1dFloatFloatSwaptionEngine(
+                        model, 64, 7.0, true, false, Handle<Quote>(),
+                        curve)));
+            instruments.push_back(swaption);
+            instruments.push_back(nonstandardSwaption);
+            instruments.push_back(floatFloatSwaption);
+        }
+    }
+
+    const Size n = instruments.size() / 2;
+    const Real tolerance = 1.0E-10;
+
+    // the second volatility checks that the cache is cleared when
+    // the model changes
+    Real testVols[] = { 0.01, 0.015 };
+    for (Size v = 0; v < LENGTH(testVols); v++) {
+        vol->setValue(testVols[v]);
+        for (Size i = 0; i < n; i++) {
+            Real expected = instruments[n + i]->NPV();
+            Real calculated = instruments[i]->NPV();
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce price with cached grids"
+                            << "\n    instrument:  " << i
+                            << "\n    volatility:  " << testVols[v]
+                            << std::setprecision(12)
+                            << "\n    cached:      " << calculated
+                            << "\n    uncached:    " << expected
+                            << std::scientific
+                            << "\n    difference:  "
+                            << calculated - expected);
+        }
+    }
+}
+
 test_suite *GsrTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("GSR model tests");
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrProcess));
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrModel));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testStateGridCache));
     return suite;
 }
@@ -25,6 +25,7 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
+#include <ql/models/equity/batesmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
@@ -35,6 +36,8 @@
 #include <ql/pricingengines/vanilla/fddividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/fdeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
+#include <ql/pricingengines/vanilla/fftslicepricer.hpp>
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -2669,6 +2672,197 @@ void HestonModelTest::testPiecewiseTimeDependentChFAsymtotic() {
     }
 }
 
+void HestonModelTest::testStrikeGridPricing() {
+    BOOST_TEST_MESSAGE("Testing Heston pricing of whole strike grids "
+                       "with cached characteristic function values...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(7, February, 2017);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const ext::shared_ptr<HestonModel> model =
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS,
+                s0, 0.08, 2.0, 0.06, 0.5, -0.7));
+
+    std::vector<Real> strikes;
+    for (Real strike=50.0; strike <= 150.0; strike+=5.0)
+        strikes.push_back(strike);
+
+    const Period maturities[] = { Period(3, Months), Period(1, Years),
+                                  Period(5, Years) };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    const AnalyticHestonEngine::ComplexLogFormula formulas[] = {
+        AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::AndersenPiterbarg
+    };
+    const AnalyticHestonEngine::Integration integrations[] = {
+        AnalyticHestonEngine::Integration::gaussLaguerre(),
+        AnalyticHestonEngine::Integration::gaussLegendre()
+    };
+
+    const Real tol = 1e-10;
+    const Array initialParams = model->params();
+
+    for (Size f=0; f < LENGTH(formulas); ++f) {
+        for (Size l=0; l < LENGTH(integrations); ++l) {
+            const ext::shared_ptr<AnalyticHestonEngine> engine =
+                ext::make_shared<AnalyticHestonEngine>(
+                    model, formulas[f], integrations[l], 1e-9);
+
+            for (Size m=0; m < 2; ++m) {
+                // the second iteration checks that a change of the
+                // model parameters resets the cached values
+                if (m == 1) {
+                    Array params = model->params();
+                    params[2] += 0.1;
+                    model->setParams(params);
+                }
+
+                for (Size i=0; i < LENGTH(maturities); ++i) {
+                    const Date maturity = settlementDate + maturities[i];
+                    const Time t = dayCounter.yearFraction(
+                        settlementDate, maturity);
+
+                    for (Size j=0; j < LENGTH(types); ++j) {
+                        const Array calculated =
+                            engine->prices(types[j], strikes, maturity);
+
+                        for (Size k=0; k < strikes.size(); ++k) {
+                            Real expected;
+                            Size evaluations;
+                            AnalyticHestonEngine::doCalculation(
+                                riskFreeTS->discount(maturity),
+                                dividendTS->discount(maturity),
+                                s0->value(), strikes[k], t,
+                                model->kappa(), model->theta(),
+                                model->sigma(), model->v0(), model->rho(),
+                                PlainVanillaPayoff(types[j], strikes[k]),
+                                integrations[l], formulas[f],
+                                engine.get(), expected, evaluations);
+
+                            VanillaOption option(
+                                ext::make_shared<PlainVanillaPayoff>(
+                                    types[j], strikes[k]),
+                                ext::make_shared<EuropeanExercise>(
+                                    maturity));
+                            option.setPricingEngine(engine);
+                            const Real npv = option.NPV();
+
+                            if (std::fabs(calculated[k]-expected) > tol
+                                || std::fabs(npv-expected) > tol) {
+                                BOOST_ERROR(
+                                    "failed to reproduce Heston prices "
+                                    "on a strike grid"
+                                    << "\n    formula   : " << f
+                                    << "\n    quadrature: " << l
+                                    << "\n    maturity  : " << maturity
+                                    << "\n    strike    : " << strikes[k]
+                                    << "\n    type      : " << types[j]
+                                    << std::setprecision(12)
+                                    << "\n    expected  : " << expected
+                                    << "\n    grid      : " << calculated[k]
+                                    << "\n    NPV       : " << npv);
+                            }
+                        }
+                    }
+                }
+            }
+            model->setParams(initialParams);
+        }
+    }
+}
+
+void HestonModelTest::testFFTSlicePricer() {
+    BOOST_TEST_MESSAGE("Testing FFT slice pricer against semi-analytic "
+                       "Heston and Bates engines...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(7, February, 2017);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const Real v0 = 0.04, kappa = 1.5, theta = 0.05, sigma = 0.6, rho = -0.6;
+
+    const ext::shared_ptr<HestonModel> hestonModel =
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, v0, kappa, theta, sigma, rho));
+    const ext::shared_ptr<BatesModel> batesModel =
+        ext::make_shared<BatesModel>(
+            ext::make_shared<BatesProcess>(
+                riskFreeTS, dividendTS, s0, v0, kappa, theta, sigma, rho,
+                0.2, -0.1, 0.15));
+
+    const ext::shared_ptr<HestonModel> models[] = {hestonModel, batesModel};
+    const ext::shared_ptr<PricingEngine> engines[] = {
+        ext::make_shared<AnalyticHestonEngine>(hestonModel, 192),
+        ext::make_shared<BatesEngine>(batesModel, 192)
+    };
+
+    std::vector<Real> strikes;
+    std::vector<Option::Type> types;
+    for (Real strike=60.0; strike <= 160.0; strike+=10.0) {
+        strikes.push_back(strike);
+        types.push_back(strike < 100.0 ? Option::Put : Option::Call);
+    }
+
+    const Period maturities[] = { Period(6, Months), Period(1, Years),
+                                  Period(3, Years) };
+
+    const FFTSlicePricer pricer;
+    const Real tol = 1e-3;
+
+    for (Size i=0; i < LENGTH(models); ++i) {
+        for (Size j=0; j < LENGTH(maturities); ++j) {
+            const Date maturity = settlementDate + maturities[j];
+            const Time t = dayCounter.yearFraction(settlementDate, maturity);
+            const DiscountFactor df = riskFreeTS->discount(maturity);
+            const Real fwd = s0->value()*dividendTS->discount(maturity)/df;
+
+            const Array calculated = pricer.prices(
+                FFTSlicePricer::characteristicFunction(models[i], t),
+                types, fwd, df, strikes);
+
+            for (Size k=0; k < strikes.size(); ++k) {
+                VanillaOption option(
+                    ext::make_shared<PlainVanillaPayoff>(types[k], strikes[k]),
+                    ext::make_shared<EuropeanExercise>(maturity));
+                option.setPricingEngine(engines[i]);
+                const Real expected = option.NPV();
+
+                if (std::fabs(calculated[k] - expected) > tol) {
+                    BOOST_ERROR("failed to reproduce option prices with "
+                                "the FFT slice pricer"
+                                << "\n    model     : "
+                                << (i == 0 ? "Heston" : "Bates")
+                                << "\n    maturity  : " << maturity
+                                << "\n    strike    : " << strikes[k]
+                                << std::setprecision(10)
+                                << "\n    expected  : " << expected
+                                << "\n    calculated: " << calculated[k]
+                                << "\n    tolerance : " << tol);
+                }
+            }
+        }
+    }
+}
+
 test_suite* HestonModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
@@ -2707,6 +2901,8 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
         &HestonModelTest::testPiecewiseTimeDependentComparison));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonModelTest::testPiecewiseTimeDependentChFAsymtotic));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testStrikeGridPricing));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFFTSlicePricer));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -47,6 +47,7 @@
 #include <ql/termstructures/volatility/equityfx/noexceptlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/gridmodellocalvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/hestonblackvolsurface.hpp>
@@ -2089,6 +2090,108 @@ void HestonSLVModelTest::testMonteCarloCalibration() {
 }
 
 
+void HestonSLVModelTest::testGriddedLocalVolSurface() {
+    BOOST_TEST_MESSAGE(
+        "Testing local volatility surface precomputed on a grid...");
+
+    SavedSettings backup;
+
+    const Date todaysDate(5, July, 2014);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Calendar calendar = TARGET();
+    const DayCounter dayCounter = Actual365Fixed();
+
+    const Handle<YieldTermStructure> rTS(
+        flatRate(todaysDate, 0.035, dayCounter));
+    const Handle<YieldTermStructure> qTS(
+        flatRate(todaysDate, 0.01, dayCounter));
+    const Handle<BlackVolTermStructure> vTS(
+        createSmoothImpliedVol(dayCounter, calendar).get<2>());
+
+    const ext::shared_ptr<SimpleQuote> spot(
+        ext::make_shared<SimpleQuote>(100.0));
+
+    const Handle<LocalVolTermStructure> localVol(
+        ext::make_shared<NoExceptLocalVolSurface>(
+            vTS, rTS, qTS, Handle<Quote>(spot), 0.2));
+
+    std::vector<Time> times;
+    for (Size i=1; i <= 38; ++i)
+        times.push_back(0.05*i);
+    std::vector<Real> strikes;
+    for (Size j=0; j <= 60; ++j)
+        strikes.push_back(60.0*std::exp(j*std::log(170.0/60.0)/60));
+
+    const GriddedLocalVolSurface<Bilinear> bilinear(
+        localVol, times, strikes);
+    const GriddedLocalVolSurface<Bicubic> bicubic(
+        localVol, times, strikes);
+
+    for (Size k=0; k < 2; ++k) {
+        for (Size i=0; i < times.size(); ++i) {
+            for (Size j=0; j < strikes.size(); ++j) {
+                const Time t = times[i];
+                const Real strike = strikes[j];
+                const Volatility expected =
+                    localVol->localVol(t, strike, true);
+
+                const Volatility calculated[] = {
+                    bilinear.localVol(t, strike, true),
+                    bicubic.localVol(t, strike, true) };
+                for (Size n=0; n < LENGTH(calculated); ++n) {
+                    if (std::fabs(calculated[n] - expected) > 1e-12)
+                        BOOST_FAIL("failed to reproduce local volatility"
+                                   " on grid node"
+                                   << "\n    spot:       " << spot->value()
+                                   << "\n    time:       " << t
+                                   << "\n    strike:     " << strike
+                                   << "\n    calculated: " << calculated[n]
+                                   << "\n    expected:   " << expected);
+                }
+
+                if (i+1 < times.size() && j+1 < strikes.size()) {
+                    // midpoint in time and log-strike: bilinear
+                    // interpolation must return the average of the
+                    // four nodes; the underlying surface is derived
+                    // from an interpolated Black surface and is not
+                    // smooth, so bicubic is only checked loosely
+                    const Time tm = 0.5*(t + times[i+1]);
+                    const Real km = std::sqrt(strike*strikes[j+1]);
+                    const Volatility expected[] = {
+                        0.25*(localVol->localVol(t, strike, true)
+                              + localVol->localVol(t, strikes[j+1], true)
+                              + localVol->localVol(times[i+1], strike, true)
+                              + localVol->localVol(times[i+1], strikes[j+1],
+                                                   true)),
+                        localVol->localVol(tm, km, true) };
+
+                    const Volatility calculated[] = {
+                        bilinear.localVol(tm, km, true),
+                        bicubic.localVol(tm, km, true) };
+                    const Real tol[] = { 1e-12, 2.5e-2 };
+                    for (Size n=0; n < LENGTH(calculated); ++n) {
+                        if (std::fabs(calculated[n] - expected[n]) > tol[n])
+                            BOOST_FAIL("failed to interpolate local "
+                                       "volatility between grid nodes"
+                                       << "\n    spot:       "
+                                       << spot->value()
+                                       << "\n    time:       " << tm
+                                       << "\n    strike:     " << km
+                                       << "\n    calculated: "
+                                       << calculated[n]
+                                       << "\n    expected:   " << expected[n]
+                                       << "\n    tolerance:  " << tol[n]);
+                    }
+                }
+            }
+        }
+
+        // the grids must be rebuilt when the underlying surface changes
+        spot->setValue(110.0);
+    }
+}
+
 void HestonSLVModelTest::testForwardSkewSLV() {
     BOOST_TEST_MESSAGE("Testing the implied volatility skew of "
         "forward starting options in SLV model...");
@@ -2513,6 +2616,8 @@ test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
         &HestonSLVModelTest::testMonteCarloVsFdmPricing));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonSLVModelTest::testLocalVolsvSLVPropDensity));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonSLVModelTest::testGriddedLocalVolSurface));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -44,6 +44,8 @@
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/experimental/volatility/noarbsabrinterpolation.hpp>
+#include <ql/termstructures/volatility/sabrsmilesection.hpp>
+#include <ql/termstructures/volatility/griddedsmilesection.hpp>
 #include <boost/foreach.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/assign/std/vector.hpp>
@@ -2446,6 +2448,60 @@ void InterpolationTest::testBackwardFlatOnSinglePoint() {
     }
 }
 
+void InterpolationTest::testSabrSmileSectionBatch() {
+
+    BOOST_TEST_MESSAGE("Testing batch and gridded evaluation of SABR "
+                       "smile sections...");
+
+    const Time expiry = 2.0;
+    const Real forward = 0.02;
+    const Real shift = 0.01;
+    std::vector<Real> params(4);
+    params[0] = 0.03; params[1] = 0.6; params[2] = 0.4; params[3] = -0.3;
+
+    const ext::shared_ptr<SmileSection> sabr =
+        ext::make_shared<SabrSmileSection>(expiry, forward, params, shift);
+
+    // strikes across the smile, including the forward and
+    // strikes below the minimum handled by the section
+    std::vector<Rate> strikes;
+    for (Rate k = -0.012; k <= 0.08; k += 0.0005)
+        strikes.push_back(k);
+    strikes.push_back(forward);
+    strikes.push_back(forward*(1.0 + 1.0e-12));
+
+    const std::vector<Volatility> batch = sabr->volatilities(strikes);
+    for (Size i=0; i<strikes.size(); ++i) {
+        const Volatility expected = sabr->volatility(strikes[i]);
+        if (std::fabs(batch[i] - expected) > 1.0e-12)
+            BOOST_ERROR("failed to reproduce SABR volatility "
+                        "with batch evaluation"
+                        << "\n    strike:     " << strikes[i]
+                        << "\n    batch:      " << batch[i]
+                        << "\n    expected:   " << expected);
+    }
+
+    std::vector<Rate> grid;
+    for (Size i=0; i<=100; ++i)
+        grid.push_back(0.001 + 0.0006*i);
+
+    const GriddedSmileSection<> gridded(sabr, grid);
+    for (Size i=0; i<strikes.size(); ++i) {
+        const Volatility calculated = gridded.volatility(strikes[i]);
+        const Volatility expected = sabr->volatility(strikes[i]);
+        const bool outside =
+            strikes[i] < grid.front() || strikes[i] > grid.back();
+        const Real tolerance = outside ? 1.0e-15 : 5.0e-5;
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce SABR volatility "
+                        "on a strike grid"
+                        << "\n    strike:     " << strikes[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected
+                        << "\n    tolerance:  " << tolerance);
+    }
+}
+
 test_suite* InterpolationTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Interpolation tests");
 
@@ -2497,6 +2553,8 @@ test_suite* InterpolationTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
         &InterpolationTest::testBackwardFlatOnSinglePoint));
+    suite->add(QUANTLIB_TEST_CASE(
+        &InterpolationTest::testSabrSmileSectionBatch));
 
 
     return suite;
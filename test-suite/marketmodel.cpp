@@ -42,6 +42,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratebatchpc.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
@@ -4731,6 +4732,166 @@ void MarketModelTest::testDriftCalculator() {
     }
 }
 
+void MarketModelTest::testBatchEvolver() {
+
+    BOOST_TEST_MESSAGE("Testing batched evolution of forward rates...");
+
+    setup();
+
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes,evolutionTimes);
+    std::vector<Size> numeraires = moneyMarketPlusMeasure(evolution,
+        measureOffset_);
+    std::vector<Size> alive = evolution.firstAliveRate();
+    Size numberOfRates = todaysForwards.size();
+    Size numberOfSteps = evolutionTimes.size();
+
+    Size testedFactors[] = { 3, numberOfRates };
+    Size batchSize = 64;
+    Size paths = 150;
+
+    for (Size k=0; k<LENGTH(testedFactors); ++k) {
+        ext::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, testedFactors[k],
+                            ExponentialCorrelationAbcdVolatility);
+
+        // drifts for a batch of perturbed forwards
+        Matrix forwards(numberOfRates, batchSize);
+        for (Size i=0; i<numberOfRates; ++i)
+            for (Size p=0; p<batchSize; ++p)
+                forwards[i][p] = todaysForwards[i]*(0.5+p/Real(batchSize));
+        Matrix drifts(numberOfRates, batchSize);
+        std::vector<Rate> pathForwards(numberOfRates);
+        std::vector<Real> pathDrifts(numberOfRates);
+        for (Size j=0; j<numberOfSteps; ++j) {
+            for (Size h=alive[j]; h<numeraires.size(); ++h) {
+                LMMDriftCalculator calculator(marketModel->pseudoRoot(j),
+                                              marketModel->displacements(),
+                                              evolution.rateTaus(),
+                                              numeraires[h], alive[j]);
+                calculator.compute(forwards, drifts);
+                for (Size p=0; p<batchSize; ++p) {
+                    std::copy(forwards.column_begin(p),
+                              forwards.column_end(p),
+                              pathForwards.begin());
+                    calculator.compute(pathForwards, pathDrifts);
+                    for (Size i=alive[j]; i<numberOfRates; ++i) {
+                        Real error = std::fabs(drifts[i][p]-pathDrifts[i]);
+                        if (error > 1.0e-15)
+                            BOOST_FAIL("failed to reproduce drifts"
+                                       << "\n    factors:    "
+                                       << testedFactors[k]
+                                       << "\n    step:       " << j
+                                       << "\n    numeraire:  "
+                                       << numeraires[h]
+                                       << "\n    rate:       " << i
+                                       << "\n    path:       " << p
+                                       << "\n    batch:      " << drifts[i][p]
+                                       << "\n    single:     "
+                                       << pathDrifts[i]);
+                    }
+                }
+            }
+        }
+
+        // paths evolved in batches, including an incomplete one
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        LogNormalFwdRatePc evolver(marketModel, generatorFactory,
+                                   numeraires);
+        LogNormalFwdRateBatchPc batchEvolver(marketModel, generatorFactory,
+                                             numeraires, 0, batchSize);
+        for (Size n=0; n<paths; ++n) {
+            Real weight = evolver.startNewPath();
+            Real batchWeight = batchEvolver.startNewPath();
+            if (weight != batchWeight)
+                BOOST_FAIL("path weights differ");
+            for (Size j=0; j<numberOfSteps; ++j) {
+                weight = evolver.advanceStep();
+                batchWeight = batchEvolver.advanceStep();
+                if (weight != batchWeight)
+                    BOOST_FAIL("step weights differ");
+                const std::vector<Rate>& expected =
+                    evolver.currentState().forwardRates();
+                const std::vector<Rate>& calculated =
+                    batchEvolver.currentState().forwardRates();
+                for (Size i=alive[j]; i<numberOfRates; ++i) {
+                    Real error = std::fabs(calculated[i]-expected[i]);
+                    if (error > 1.0e-15)
+                        BOOST_FAIL("failed to reproduce evolved forwards"
+                                   << "\n    factors:    "
+                                   << testedFactors[k]
+                                   << "\n    path:       " << n
+                                   << "\n    step:       " << j
+                                   << "\n    rate:       " << i
+                                   << "\n    batch:      " << calculated[i]
+                                   << "\n    single:     " << expected[i]);
+                }
+            }
+        }
+    }
+}
+
+void MarketModelTest::testParallelAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing accounting engine with several evolvers...");
+
+    setup();
+
+    std::vector<ext::shared_ptr<Payoff> > payoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i)
+        payoffs[i] = ext::shared_ptr<Payoff>(
+                      new PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    MultiStepOptionlets product(rateTimes, accruals, paymentTimes, payoffs);
+
+    EvolutionDescription evolution = product.evolution();
+    ext::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 4,
+                        ExponentialCorrelationAbcdVolatility);
+    std::vector<Size> numeraires = makeMeasure(product, MoneyMarket);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    Size nEvolvers = 3, pathsPerBlock = 50, paths = 400;
+
+    std::vector<ext::shared_ptr<MarketModelEvolver> > evolvers, serial;
+    for (Size i=0; i<nEvolvers; ++i) {
+        MTBrownianGeneratorFactory generatorFactory(seed_+i);
+        evolvers.push_back(makeMarketModelEvolver(marketModel, numeraires,
+                                                  generatorFactory, Pc));
+        serial.push_back(makeMarketModelEvolver(marketModel, numeraires,
+                                                generatorFactory, Pc));
+    }
+
+    AccountingEngine engine(evolvers, product, initialNumeraireValue,
+                            pathsPerBlock);
+    SequenceStatisticsInc stats(product.numberOfProducts());
+    engine.multiplePathValues(stats, paths);
+
+    // the same paths, simulated and collected in the same order
+    std::vector<ext::shared_ptr<AccountingEngine> > engines;
+    for (Size i=0; i<nEvolvers; ++i)
+        engines.push_back(ext::make_shared<AccountingEngine>(
+                              serial[i], product, initialNumeraireValue));
+    SequenceStatisticsInc expected(product.numberOfProducts());
+    for (Size done=0, i=0; done<paths; i=(i+1)%nEvolvers) {
+        Size n = std::min(pathsPerBlock, paths-done);
+        engines[i]->multiplePathValues(expected, n);
+        done += n;
+    }
+
+    if (stats.samples() != paths)
+        BOOST_FAIL("wrong number of samples: " << stats.samples()
+                   << " instead of " << paths);
+    std::vector<Real> means = stats.mean(), expectedMeans = expected.mean();
+    for (Size i=0; i<means.size(); ++i) {
+        if (std::fabs(means[i]-expectedMeans[i]) > 1.0e-15)
+            BOOST_FAIL("failed to reproduce optionlet values"
+                       << "\n    optionlet:  " << i
+                       << "\n    calculated: " << means[i]
+                       << "\n    expected:   " << expectedMeans[i]);
+    }
+}
+
 void MarketModelTest::testIsInSubset() {
 
     // Performance test for isInSubset function (temporary)
@@ -4882,6 +5043,9 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPeriodAdapter));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBatchEvolver));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &MarketModelTest::testParallelAccountingEngine));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testIsInSubset));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
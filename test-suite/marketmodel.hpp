@@ -52,6 +52,8 @@ class MarketModelTest {
     static void testAbcdVolatilityCompare();
     static void testAbcdVolatilityFit();
     static void testDriftCalculator();
+    static void testBatchEvolver();
+    static void testParallelAccountingEngine();
     static void testIsInSubset();
     static void testAbcdDegenerateCases();
     static void testCovariance();
@@ -816,6 +816,69 @@ void OptionletStripperTest::testSwitchStrike() {
                    << "\ntolerance:     " << io::rate(vars.tolerance));
 }
 
+void OptionletStripperTest::testCapFloorPrices() {
+    BOOST_TEST_MESSAGE("Testing cap/floor prices used by OptionletStripper1 "
+                       "against cap/floor engines...");
+
+    CommonVars vars;
+    Settings::instance().evaluationDate() = Date(30, April, 2015);
+
+    vars.setRealCapFloorTermVolSurface();
+
+    shared_ptr< IborIndex > iborIndex(new Euribor6M(vars.forwardingYTS));
+
+    const VolatilityType types[] = { Normal, ShiftedLognormal };
+    const Real displacements[] = { 0.0, 0.01 };
+
+    for (Size k = 0; k < LENGTH(types); ++k) {
+        ext::shared_ptr< OptionletStripper1 > optionletStripper1(
+            new OptionletStripper1(vars.capFloorVolRealSurface, iborIndex,
+                                   Null< Rate >(), vars.accuracy, 100,
+                                   vars.discountingYTS, types[k],
+                                   displacements[k], true));
+
+        const Matrix& prices = optionletStripper1->capFloorPrices();
+        const Matrix& vols = optionletStripper1->capFloorVolatilities();
+        const Rate switchStrike = optionletStripper1->switchStrike();
+        const std::vector<Rate>& strikes =
+            vars.capFloorVolRealSurface->strikes();
+
+        for (Size i = 0; i < prices.rows(); ++i) {
+            const Period length =
+                optionletStripper1->optionletFixingTenors()[i]
+                + iborIndex->tenor();
+            for (Size j = 0; j < strikes.size(); ++j) {
+                ext::shared_ptr< PricingEngine > engine;
+                if (types[k] == Normal)
+                    engine = ext::make_shared< BachelierCapFloorEngine >(
+                        vars.discountingYTS, vols[i][j],
+                        vars.capFloorVolRealSurface->dayCounter());
+                else
+                    engine = ext::make_shared< BlackCapFloorEngine >(
+                        vars.discountingYTS, vols[i][j],
+                        vars.capFloorVolRealSurface->dayCounter(),
+                        displacements[k]);
+
+                ext::shared_ptr< CapFloor > capFloor =
+                    MakeCapFloor(strikes[j] < switchStrike ? CapFloor::Floor
+                                                           : CapFloor::Cap,
+                                 length, iborIndex, strikes[j], 0 * Days)
+                    .withPricingEngine(engine);
+
+                Real expected = capFloor->NPV();
+                Real error = std::fabs(prices[i][j] - expected);
+                if (error > 1.0e-12)
+                    BOOST_FAIL("\nvolatility type: " << types[k]
+                               << "\nlength:          " << length
+                               << "\nstrike:          " << io::rate(strikes[j])
+                               << "\nstripper price:  " << prices[i][j]
+                               << "\nengine price:    " << expected
+                               << "\nerror:           " << error);
+            }
+        }
+    }
+}
+
 test_suite* OptionletStripperTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("OptionletStripper Tests");
     suite->add(QUANTLIB_TEST_CASE(
@@ -832,6 +895,8 @@ test_suite* OptionletStripperTest::suite() {
         &OptionletStripperTest::testTermVolatilityStrippingNormalVol));
     suite->add(QUANTLIB_TEST_CASE(
         &OptionletStripperTest::testTermVolatilityStrippingShiftedLogNormalVol));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OptionletStripperTest::testCapFloorPrices));
 
     return suite;
 }
@@ -288,6 +288,87 @@ void ShortRateModelTest::testCachedHullWhite2() {
     }
 }
 
+void ShortRateModelTest::testParallelCalibration() {
+    BOOST_TEST_MESSAGE("Testing parallel Hull-White calibration "
+                       "against sequential calibration...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    ext::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    ext::shared_ptr<HullWhite> sequentialModel(new HullWhite(termStructure));
+    ext::shared_ptr<HullWhite> parallelModel(new HullWhite(termStructure));
+    parallelModel->setParallelCalibration(true);
+
+    std::vector<ext::shared_ptr<BlackCalibrationHelper> >
+        sequentialSwaptions, parallelSwaptions;
+    ext::shared_ptr<PricingEngine> sharedEngine(
+                               new JamshidianSwaptionEngine(sequentialModel));
+    for (Size i=0; i<LENGTH(data); i++) {
+        ext::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+        for (Size k=0; k<2; ++k) {
+            ext::shared_ptr<BlackCalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+            if (k == 0) {
+                helper->setPricingEngine(sharedEngine);
+                sequentialSwaptions.push_back(helper);
+            } else {
+                // each helper needs its own engine when run in parallel
+                helper->setPricingEngine(ext::shared_ptr<PricingEngine>(
+                               new JamshidianSwaptionEngine(parallelModel)));
+                parallelSwaptions.push_back(helper);
+            }
+        }
+    }
+
+    LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+
+    sequentialModel->calibrate(sequentialSwaptions, optimizationMethod,
+                               endCriteria);
+    parallelModel->calibrate(parallelSwaptions, optimizationMethod,
+                             endCriteria);
+
+    Array expected = sequentialModel->params();
+    Array calculated = parallelModel->params();
+    Real tolerance = 1.0e-12;
+    for (Size i=0; i<expected.size(); ++i) {
+        if (std::fabs(calculated[i]-expected[i]) > tolerance)
+            BOOST_ERROR("Failed to reproduce sequential calibration:"
+                        << "\n  parameter : " << i
+                        << std::scientific
+                        << "\n  sequential: " << expected[i]
+                        << "\n  parallel  : " << calculated[i]);
+    }
+
+    Array sequentialErrors = sequentialModel->problemValues();
+    Array parallelErrors = parallelModel->problemValues();
+    for (Size i=0; i<sequentialErrors.size(); ++i) {
+        if (std::fabs(parallelErrors[i]-sequentialErrors[i]) > tolerance)
+            BOOST_ERROR("Failed to reproduce sequential calibration errors:"
+                        << "\n  helper    : " << i
+                        << std::scientific
+                        << "\n  sequential: " << sequentialErrors[i]
+                        << "\n  parallel  : " << parallelErrors[i]);
+    }
+}
+
 void ShortRateModelTest::testSwaps() {
     BOOST_TEST_MESSAGE("Testing Hull-White swap pricing against known values...");
 
@@ -465,6 +546,7 @@ test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhiteFixedReversion));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testParallelCalibration));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
     suite->add(QUANTLIB_TEST_CASE(
         &ShortRateModelTest::testExtendedCoxIngersollRossDiscountFactor));
@@ -32,6 +32,7 @@ class ShortRateModelTest {
     static void testCachedHullWhite();
     static void testCachedHullWhiteFixedReversion();
     static void testCachedHullWhite2();
+    static void testParallelCalibration();
     static void testSwaps();
     static void testExtendedCoxIngersollRossDiscountFactor();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
@@ -27,6 +27,7 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
@@ -124,6 +125,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<StreamingStatistics>(std::string("StreamingStatistics"));
 }
 
 
@@ -247,6 +249,81 @@ void StatisticsTest::testSequenceStatistics() {
 }
 
 
+void StatisticsTest::testSequenceCovariance() {
+
+    BOOST_TEST_MESSAGE("Testing sequence statistics covariance...");
+
+    MersenneTwisterUniformRng mt(42);
+
+    const Size dimension = 40, nSamples = 1000, nParts = 3;
+    std::vector<std::vector<Real> > samples(nSamples,
+                                            std::vector<Real>(dimension));
+    std::vector<Real> weights(nSamples);
+    for (Size k=0; k<nSamples; ++k) {
+        weights[k] = mt.nextReal();
+        // correlated components
+        Real common = mt.nextReal();
+        for (Size i=0; i<dimension; ++i)
+            samples[k][i] = common*(i+1.0) + mt.nextReal();
+    }
+
+    // straightforward calculation of the weighted covariance
+    std::vector<Real> mean(dimension, 0.0);
+    Real weightSum = 0.0;
+    for (Size k=0; k<nSamples; ++k) {
+        weightSum += weights[k];
+        for (Size i=0; i<dimension; ++i)
+            mean[i] += weights[k]*samples[k][i];
+    }
+    for (Size i=0; i<dimension; ++i)
+        mean[i] /= weightSum;
+    Matrix expected(dimension, dimension, 0.0);
+    for (Size k=0; k<nSamples; ++k)
+        for (Size i=0; i<dimension; ++i)
+            for (Size j=0; j<dimension; ++j)
+                expected[i][j] += weights[k]*(samples[k][i]-mean[i])
+                                            *(samples[k][j]-mean[j]);
+    for (Size i=0; i<dimension; ++i)
+        for (Size j=0; j<dimension; ++j)
+            expected[i][j] *= nSamples/((nSamples-1.0)*weightSum);
+
+    SequenceStatistics whole;
+    std::vector<SequenceStatistics> parts(nParts);
+    for (Size k=0; k<nSamples; ++k) {
+        whole.add(samples[k], weights[k]);
+        parts[k % nParts].add(samples[k], weights[k]);
+    }
+    SequenceStatistics merged;
+    for (Size p=0; p<nParts; ++p)
+        merged.merge(parts[p]);
+
+    if (merged.samples() != nSamples)
+        BOOST_ERROR("wrong number of merged samples"
+                    << "\n    calculated: " << merged.samples()
+                    << "\n    expected:   " << nSamples);
+
+    Matrix calculated = whole.covariance();
+    Matrix fromParts = merged.covariance();
+    Real tolerance = 1.0e-10;
+    for (Size i=0; i<dimension; ++i) {
+        for (Size j=0; j<dimension; ++j) {
+            if (std::fabs(calculated[i][j] - expected[i][j]) > tolerance)
+                BOOST_ERROR("wrong covariance"
+                            << "\n    element:    (" << i << "," << j << ")"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated[i][j]
+                            << "\n    expected:   " << expected[i][j]);
+            if (std::fabs(fromParts[i][j] - expected[i][j]) > tolerance)
+                BOOST_ERROR("wrong covariance from merged statistics"
+                            << "\n    element:    (" << i << "," << j << ")"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << fromParts[i][j]
+                            << "\n    expected:   " << expected[i][j]);
+        }
+    }
+}
+
+
 namespace {
 
     template <class S>
@@ -389,11 +466,103 @@ void StatisticsTest::testIncrementalStatistics() {
                                  << tol);
 }
 
+void StatisticsTest::testStreamingStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing streaming statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeNormal inverse;
+
+    const Size nSamples = 200000, nParts = 4;
+    // samples are collected in parts which are merged afterwards,
+    // as it would happen in a parallel simulation
+    std::vector<StreamingRiskStatistics> parts(nParts);
+    RiskStatistics reference;
+    for (Size i = 0; i < nSamples; ++i) {
+        Real x = inverse(mt.nextReal());
+        Real w = mt.nextReal();
+        parts[i % nParts].add(x, w);
+        reference.add(x, w);
+    }
+    StreamingRiskStatistics stat;
+    for (Size i = 0; i < nParts; ++i)
+        stat.merge(parts[i]);
+
+    if (stat.samples() != nSamples)
+        BOOST_ERROR("wrong number of samples"
+                    << "\n    calculated: " << stat.samples()
+                    << "\n    expected:   " << nSamples);
+    if (stat.centroids() > stat.compression())
+        BOOST_ERROR("too many centroids"
+                    << "\n    centroids:   " << stat.centroids()
+                    << "\n    compression: " << stat.compression());
+
+    Real tolerance = 1.0e-10;
+    Real calculated[] = { stat.weightSum(), stat.mean(), stat.variance(),
+                          stat.skewness(), stat.kurtosis(),
+                          stat.min(), stat.max() };
+    Real expected[] = { reference.weightSum(), reference.mean(),
+                        reference.variance(), reference.skewness(),
+                        reference.kurtosis(), reference.min(),
+                        reference.max() };
+    std::string names[] = { "weight sum", "mean", "variance", "skewness",
+                            "kurtosis", "minimum", "maximum" };
+    for (Size i = 0; i < LENGTH(names); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > tolerance)
+            BOOST_ERROR("wrong " << names[i]
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+
+    // the probability level of the estimated percentiles must be
+    // within the documented error bound
+    Real levels[] = { 0.001, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99,
+                      0.999 };
+    const std::vector<std::pair<Real,Real> >& data = reference.data();
+    for (Size i = 0; i < LENGTH(levels); ++i) {
+        Real q = levels[i];
+        Real bound =
+            2.0*M_PI/stat.compression()*std::sqrt(q*(1.0-q));
+        Real x = stat.percentile(q), y = stat.topPercentile(q);
+        Real below = 0.0, above = 0.0;
+        for (Size j = 0; j < data.size(); ++j) {
+            if (data[j].first < x)
+                below += data[j].second;
+            if (data[j].first > y)
+                above += data[j].second;
+        }
+        below /= reference.weightSum();
+        above /= reference.weightSum();
+        if (std::fabs(below - q) > bound)
+            BOOST_ERROR("percentile out of error bound"
+                        << "\n    level:       " << q
+                        << "\n    percentile:  " << x
+                        << "\n    exact level: " << below
+                        << "\n    bound:       " << bound);
+        if (std::fabs(above - q) > bound)
+            BOOST_ERROR("top percentile out of error bound"
+                        << "\n    level:       " << q
+                        << "\n    percentile:  " << y
+                        << "\n    exact level: " << above
+                        << "\n    bound:       " << bound);
+    }
+
+    Real shortfall = stat.expectedShortfall(0.99);
+    Real expectedShortfall = reference.expectedShortfall(0.99);
+    if (std::fabs(shortfall/expectedShortfall - 1.0) > 0.02)
+        BOOST_ERROR("wrong expected shortfall"
+                    << "\n    calculated: " << shortfall
+                    << "\n    expected:   " << expectedShortfall);
+}
+
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceCovariance));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testIncrementalStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStreamingStatistics));
     return suite;
 }
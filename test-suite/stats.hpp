@@ -31,8 +31,10 @@ class StatisticsTest {
   public:
     static void testStatistics();
     static void testSequenceStatistics();
+    static void testSequenceCovariance();
     static void testConvergenceStatistics();
     static void testIncrementalStatistics();
+    static void testStreamingStatistics();
     static boost::unit_test_framework::test_suite* suite();
 };
 
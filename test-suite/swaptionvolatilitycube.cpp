@@ -442,6 +442,128 @@ void SwaptionVolatilityCubeTest::testObservability() {
     Settings::instance().evaluationDate() = referenceDate;
 }
 
+void SwaptionVolatilityCubeTest::testIncrementalCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing incremental sabr calibration of "
+                       "swaption volatility cube...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    SwaptionVolCube1 volCube(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             true);
+    SwaptionVolCube1 warmStartedCube(vars.atmVolMatrix,
+                                     vars.cube.tenors.options,
+                                     vars.cube.tenors.swaps,
+                                     vars.cube.strikeSpreads,
+                                     vars.cube.volSpreadsHandle,
+                                     vars.swapIndexBase,
+                                     vars.shortSwapIndexBase,
+                                     vars.vegaWeighedSmileFit,
+                                     parametersGuess,
+                                     isParameterFixed,
+                                     true);
+    warmStartedCube.enableWarmStart();
+
+    // trigger the calibration before the market moves
+    volCube.denseSabrParameters();
+    warmStartedCube.denseSabrParameters();
+
+    ext::shared_ptr<SimpleQuote> volSpread =
+        ext::dynamic_pointer_cast<SimpleQuote>(
+                                 vars.cube.volSpreadsHandle[1][0].currentLink());
+    volSpread->setValue(volSpread->value() + 0.002);
+
+    // a cube built from scratch after the move
+    SwaptionVolCube1 freshCube(vars.atmVolMatrix,
+                               vars.cube.tenors.options,
+                               vars.cube.tenors.swaps,
+                               vars.cube.strikeSpreads,
+                               vars.cube.volSpreadsHandle,
+                               vars.swapIndexBase,
+                               vars.shortSwapIndexBase,
+                               vars.vegaWeighedSmileFit,
+                               parametersGuess,
+                               isParameterFixed,
+                               true);
+
+    // the incremental calibration must reproduce the full one
+    Matrix sparse[] = { volCube.sparseSabrParameters(),
+                        freshCube.sparseSabrParameters() };
+    Matrix dense[] = { volCube.denseSabrParameters(),
+                       freshCube.denseSabrParameters() };
+    for (Size i=0; i<sparse[0].rows(); i++) {
+        for (Size j=0; j<sparse[0].columns(); j++) {
+            if (std::fabs(sparse[0][i][j] - sparse[1][i][j]) > 1.0e-14)
+                BOOST_ERROR("incremental calibration of sparse sabr "
+                            "parameters failed at (" << i << ", " << j << ")"
+                            << "\n incremental = " << sparse[0][i][j]
+                            << "\n full        = " << sparse[1][i][j]);
+        }
+    }
+    for (Size i=0; i<dense[0].rows(); i++) {
+        for (Size j=0; j<dense[0].columns(); j++) {
+            if (std::fabs(dense[0][i][j] - dense[1][i][j]) > 1.0e-14)
+                BOOST_ERROR("incremental calibration of dense sabr "
+                            "parameters failed at (" << i << ", " << j << ")"
+                            << "\n incremental = " << dense[0][i][j]
+                            << "\n full        = " << dense[1][i][j]);
+        }
+    }
+
+    // a warm-started calibration may end in a different point,
+    // but both must fit the market within the calibration tolerance
+    Real tolerance = 1.0e-3;
+    for (Size i=0; i<vars.cube.tenors.options.size(); i++) {
+        for (Size j=0; j<vars.cube.tenors.swaps.size(); j++) {
+            for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+                Rate strike = freshCube.atmStrike(vars.cube.tenors.options[i],
+                                                  vars.cube.tenors.swaps[j])
+                    + vars.cube.strikeSpreads[k];
+                Volatility expected =
+                    freshCube.volatility(vars.cube.tenors.options[i],
+                                         vars.cube.tenors.swaps[j],
+                                         strike, true);
+                Volatility calculated =
+                    warmStartedCube.volatility(vars.cube.tenors.options[i],
+                                               vars.cube.tenors.swaps[j],
+                                               strike, true);
+                if (std::fabs(calculated - expected) > tolerance)
+                    BOOST_ERROR("warm-started calibration failed:"
+                                "\n option tenor = " << vars.cube.tenors.options[i] <<
+                                "\n   swap tenor = " << vars.cube.tenors.swaps[j] <<
+                                "\n       strike = " << io::rate(strike) <<
+                                "\n warm started = " << io::volatility(calculated) <<
+                                "\n  full        = " << io::volatility(expected) <<
+                                "\n    tolerance = " << tolerance);
+            }
+        }
+    }
+}
+
 test_suite* SwaptionVolatilityCubeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Cube tests");
 
@@ -458,6 +580,8 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
                              &SwaptionVolatilityCubeTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &SwaptionVolatilityCubeTest::testIncrementalCalibration));
 
     return suite;
 }
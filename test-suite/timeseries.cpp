@@ -23,6 +23,10 @@
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/indexes/fixingstore.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <cstdio>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -193,11 +197,121 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testFixingStore() {
+    BOOST_TEST_MESSAGE("Testing columnar fixing store...");
+
+    FixingStore store;
+    FixingStore::Key daily = store.key("Daily index");
+    FixingStore::Key monthly = store.key("Monthly index");
+
+    if (store.key("DAILY INDEX") != daily)
+        BOOST_ERROR("index names are not case insensitive");
+    if (store.name(monthly) != "MONTHLY INDEX")
+        BOOST_ERROR("wrong name returned: " << store.name(monthly));
+
+    // business-day fixings, given in reverse order
+    TARGET calendar;
+    TimeSeries<Real> dailyFixings, monthlyFixings;
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    Date d = calendar.adjust(Date(2, January, 2015));
+    for (Size i=0; i<1000; ++i, d = calendar.advance(d, 1, Days)) {
+        dailyFixings[d] = 0.01 + 1e-5*i;
+        dates.push_back(d);
+        values.push_back(0.01 + 1e-5*i);
+    }
+    std::reverse(dates.begin(), dates.end());
+    std::reverse(values.begin(), values.end());
+    store.load(daily, dates, values);
+
+    for (Size i=0; i<60; ++i)
+        monthlyFixings[Date(15, January, 2015) + i*Months] = 100.0 + i;
+    store.load(monthly, monthlyFixings);
+
+    if (!store.isDense(daily))
+        BOOST_ERROR("daily fixings not stored densely");
+    if (store.isDense(monthly))
+        BOOST_ERROR("monthly fixings stored densely");
+    if (store.fixings(daily) != dailyFixings.size()
+        || store.firstDate(daily) != dailyFixings.firstDate()
+        || store.lastDate(daily) != dailyFixings.lastDate())
+        BOOST_ERROR("wrong daily fixing range");
+
+    // look-ups in a time series add null fixings to it
+    TimeSeries<Real> dailyLookup = dailyFixings,
+                     monthlyLookup = monthlyFixings;
+    for (Date t = Date(25, December, 2014);
+         t < Date(1, January, 2020); ++t) {
+        Real expected = dailyLookup[t];
+        Real calculated = store.fixing(daily, t);
+        if (calculated != expected)
+            BOOST_ERROR("wrong daily fixing at " << t
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+        expected = monthlyLookup[t];
+        calculated = store.fixing(monthly, t);
+        if (calculated != expected)
+            BOOST_ERROR("wrong monthly fixing at " << t
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    // snapshots
+    FixingStore::Snapshot snapshot = store.snapshot();
+    Date today(15, March, 2016);
+    std::vector<Real> shifted(10, 1.0);
+    store.loadDaily(daily, today, shifted);
+    FixingStore::Key other = store.key("Other index");
+    store.load(other, monthlyFixings);
+    if (store.fixing(daily, today) != 1.0
+        || store.fixing(daily, today-1) != Null<Real>())
+        BOOST_ERROR("daily fixings not replaced");
+
+    store.restore(snapshot);
+    if (store.fixing(daily, today) != dailyLookup[today])
+        BOOST_ERROR("daily fixings not restored");
+    if (store.fixings(other) != 0)
+        BOOST_ERROR("fixings added after snapshot not removed");
+
+    // persistence
+    const std::string fileName = "fixingstore.tmp";
+    store.save(fileName);
+    FixingStore loaded;
+    loaded.loadFile(fileName);
+    std::remove(fileName.c_str());
+
+    if (loaded.size() != 2)
+        BOOST_ERROR("wrong number of indexes loaded: " << loaded.size());
+    FixingStore::Key keys[] = { daily, monthly };
+    for (Size k=0; k<2; ++k) {
+        FixingStore::Key l = loaded.key(store.name(keys[k]));
+        std::vector<Date> d1 = store.timeSeries(keys[k]).dates();
+        std::vector<Real> v1 = store.timeSeries(keys[k]).values();
+        std::vector<Date> d2 = loaded.timeSeries(l).dates();
+        std::vector<Real> v2 = loaded.timeSeries(l).values();
+        if (d1 != d2 || v1 != v2)
+            BOOST_ERROR("fixings of " << store.name(keys[k])
+                        << " not restored from file");
+    }
+
+    // publishing to the index manager
+    store.publish();
+    const TimeSeries<Real>& history =
+        IndexManager::instance().getHistory("daily index");
+    if (history.size() != dailyFixings.size()
+        || history.values() != dailyFixings.values())
+        BOOST_ERROR("fixings not published to the index manager");
+    IndexManager::instance().clearHistory("daily index");
+    IndexManager::instance().clearHistory("monthly index");
+    IndexManager::instance().clearHistory("other index");
+}
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testFixingStore));
     return suite;
 }
 